@@ -0,0 +1,494 @@
+/*
+	Render command list. Everything the widgets draw (filled
+	rectangles, glyph quads, anti-aliased meshes from
+	primitives.c, texture copies and clip pushes/pops) is
+	recorded as a compact command instead of being sent to SDL
+	right away.
+
+	When the list is flushed, consecutive commands of equal
+	render state (kind, texture, clip) are grouped into runs and
+	the runs are sorted by state wherever the z-order allows it:
+	a run only moves ahead of runs it doesn't overlap. The sorted
+	list is replayed in one pass, quads and meshes going out
+	through SDL_RenderGeometry() in as few calls as possible.
+
+	Inside GUI_RenderElements() a whole frame is recorded;
+	elements rendered on their own are replayed right away.
+	Anything that changes renderer state directly (render
+	targets) flushes the list first.
+*/
+
+#include <stdlib.h> // qsort
+#include <SDL2/SDL.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define MIN_COMMANDS 		256
+#define MIN_VERTICES 		1024
+#define MAX_CLIPS 			256 	// clip pushes per flush, deeper pushes reuse their parent's clip
+#define MAX_SORTED_RUNS 	2048 	// longer lists are replayed in recorded order
+
+typedef struct {
+	int start, end; 		// commands [start, end) of the list
+	int seq, layer; 		// recorded position, depth among overlapping runs
+	int clip; 				// index into the clip table, 0: the renderer's own clip
+	GUI_CommandType type;
+	SDL_Texture *texture;
+	SDL_Rect bounds; 		// area touched by the run (clipped)
+} GUI_CommandRun;
+
+static GUI_DrawCommand *commands = NULL;
+static int command_count = 0, command_cap = 0;
+
+static GUI_CommandRun *runs = NULL;
+static int run_cap = 0;
+static int *command_clip = NULL; 			// clip index of every command
+static int command_clip_cap = 0;
+static SDL_Rect clips[MAX_CLIPS];
+
+static SDL_Vertex *vertices = NULL; 		// geometry of one state being replayed
+static int *indices = NULL;
+static int vertex_count = 0, vertex_cap = 0,
+	index_count = 0, index_cap = 0,
+	quad_count = 0; 						// quads among the geometry (stats)
+
+static GUI_DrawCommand *captured = NULL; 	// commands of the last frame (GUI_SetFrameCapture)
+static int captured_count = 0, captured_cap = 0;
+static int capture_enabled = 0, replaying_capture = 0;
+
+static SDL_Color draw_color = { 0, 0, 0, 255 };
+static int frame_depth = 0; 				// > 0 while a frame is being recorded
+static GUI_RenderStats stats = {0};
+
+// grow an array to hold at least 'count' items, returns 0 when out of memory
+static int __gui_reserve(void **array, int *cap, int count, size_t item_size, int min_cap) {
+	if (count <= *cap) return 1;
+
+	int new_cap = *cap ? *cap : min_cap;
+	while (new_cap < count) new_cap *= 2;
+
+	void *p = __gui_realloc(*array, item_size * new_cap, GUI_MEM_RENDER);
+	if (!p) return 0;
+	*array = p;
+	*cap = new_cap;
+	return 1;
+}
+
+static int __gui_reserve_geometry(int vertex_add, int index_add) {
+	return __gui_reserve((void **)&vertices, &vertex_cap, vertex_count + vertex_add, sizeof(SDL_Vertex), MIN_VERTICES) &&
+		__gui_reserve((void **)&indices, &index_cap, index_count + index_add, sizeof(int), MIN_VERTICES * 3 / 2);
+}
+
+static GUI_DrawCommand *__gui_record(GUI_CommandType type) {
+	if (!__gui_reserve((void **)&commands, &command_cap, command_count + 1, sizeof(GUI_DrawCommand), MIN_COMMANDS)) {
+		__gui_batch_flush(); 	// out of memory, draw what we have and reuse the list
+		if (command_cap == 0) return NULL;
+	}
+	GUI_DrawCommand *c = &commands[command_count++];
+	*c = (GUI_DrawCommand){ .type = type };
+	return c;
+}
+
+/* Replay */
+
+// area a command draws to, before clipping
+static SDL_Rect __gui_command_bounds(const GUI_DrawCommand *c) {
+	if (c->type == GUI_CMD_MESH) { 	// rect holds the origin
+		SDL_Rect b = c->mesh->bounds;
+		int x = (int)SDL_floorf(c->rect.x), y = (int)SDL_floorf(c->rect.y);
+		return (SDL_Rect){ b.x + x, b.y + y, b.w + 1, b.h + 1 };
+	}
+	int x = (int)SDL_floorf(c->rect.x), y = (int)SDL_floorf(c->rect.y);
+	return (SDL_Rect){ x, y, (int)SDL_ceilf(c->rect.x + c->rect.w) - x, (int)SDL_ceilf(c->rect.y + c->rect.h) - y };
+}
+
+// meshes and colored quads are the same kind of geometry and share a draw call
+static GUI_CommandType __gui_command_kind(const GUI_DrawCommand *c) {
+	return c->type == GUI_CMD_MESH ? GUI_CMD_QUAD : c->type;
+}
+
+static int __gui_run_state_differs(const GUI_CommandRun *a, const GUI_CommandRun *b) {
+	return a->type != b->type || a->texture != b->texture || a->clip != b->clip;
+}
+
+static int __gui_compare_runs(const void *pa, const void *pb) {
+	const GUI_CommandRun *a = pa, *b = pb;
+	if (a->layer != b->layer) return a->layer < b->layer ? -1 : 1;
+	if (a->type != b->type) return a->type < b->type ? -1 : 1;
+	if (a->texture != b->texture) return (uintptr_t)a->texture < (uintptr_t)b->texture ? -1 : 1;
+	if (a->clip != b->clip) return a->clip < b->clip ? -1 : 1;
+	return a->seq - b->seq; 	// equal state stays in recorded order
+}
+
+// resolve clip pushes/pops and group consecutive commands of equal state into runs, returns the run count
+static int __gui_build_runs(const SDL_Rect *base_clip) {
+	if (!__gui_reserve((void **)&command_clip, &command_clip_cap, command_count, sizeof(int), MIN_COMMANDS) ||
+		!__gui_reserve((void **)&runs, &run_cap, command_count, sizeof(GUI_CommandRun), MIN_COMMANDS))
+		return -1;
+
+	int stack[MAX_CLIPS], depth = 0, clip_count = 1, run_count = 0;
+	stack[0] = 0;
+	if (base_clip) clips[0] = *base_clip;
+
+	for (int i = 0; i < command_count; i++) {
+		GUI_DrawCommand *c = &commands[i];
+
+		if (c->type == GUI_CMD_PUSH_CLIP) {
+			SDL_Rect r = { (int)c->rect.x, (int)c->rect.y, (int)c->rect.w, (int)c->rect.h };
+			int parent = stack[depth];
+			if ((parent != 0 || base_clip) && !SDL_IntersectRect(&r, &clips[parent], &r))
+				r.w = r.h = 0; 	// nothing is visible until the matching pop
+
+			if (clip_count < MAX_CLIPS) {
+				clips[clip_count] = r;
+				stack[++depth] = clip_count++;
+			} else {
+				stack[++depth] = parent;
+			}
+			continue;
+		}
+		if (c->type == GUI_CMD_POP_CLIP) {
+			if (depth > 0) depth--;
+			continue;
+		}
+
+		int clip = stack[depth];
+		GUI_CommandType kind = __gui_command_kind(c);
+		command_clip[i] = clip;
+
+		SDL_Rect bounds = __gui_command_bounds(c);
+		if ((clip != 0 || base_clip) && !SDL_IntersectRect(&bounds, &clips[clip], &bounds))
+			continue; 	// clipped away entirely
+
+		GUI_CommandRun *last = run_count ? &runs[run_count - 1] : NULL;
+		if (last && last->type == kind && last->texture == c->texture && last->clip == clip) {
+			SDL_UnionRect(&last->bounds, &bounds, &last->bounds);
+			last->end = i + 1;
+			continue;
+		}
+		runs[run_count] = (GUI_CommandRun){ i, i + 1, run_count, 0, clip, kind, c->texture, bounds };
+		run_count++;
+	}
+	return run_count;
+}
+
+// a run has to come after every earlier run it overlaps, in a later layer if their state differs
+static void __gui_sort_runs(int run_count) {
+	if (run_count < 2 || run_count > MAX_SORTED_RUNS) return;
+
+	for (int r = 1; r < run_count; r++) {
+		int layer = 0;
+		for (int p = 0; p < r; p++) {
+			int needed = runs[p].layer + __gui_run_state_differs(&runs[p], &runs[r]);
+			if (needed > layer && SDL_HasIntersection(&runs[p].bounds, &runs[r].bounds))
+				layer = needed;
+		}
+		runs[r].layer = layer;
+	}
+	qsort(runs, run_count, sizeof(GUI_CommandRun), __gui_compare_runs);
+}
+
+static void __gui_submit_geometry(SDL_Renderer *renderer, SDL_Texture *texture) {
+	if (index_count == 0) return;
+
+	// untextured geometry blends with the draw blend mode, anti-aliased edges need blending
+	SDL_BlendMode mode = SDL_BLENDMODE_NONE;
+	if (!texture) {
+		SDL_GetRenderDrawBlendMode(renderer, &mode);
+		SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	}
+	SDL_RenderGeometry(renderer, texture, vertices, vertex_count, indices, index_count);
+	if (!texture) SDL_SetRenderDrawBlendMode(renderer, mode);
+
+	stats.draw_calls++;
+	stats.quads += quad_count;
+	vertex_count = index_count = quad_count = 0;
+}
+
+static void __gui_replay_run(SDL_Renderer *renderer, const GUI_CommandRun *run) {
+	for (int i = run->start; i < run->end; i++) {
+		const GUI_DrawCommand *c = &commands[i];
+		if (c->type == GUI_CMD_PUSH_CLIP || c->type == GUI_CMD_POP_CLIP || command_clip[i] != run->clip) continue;
+
+		if (c->type == GUI_CMD_QUAD) {
+			if (!__gui_reserve_geometry(4, 6)) {
+				__gui_submit_geometry(renderer, run->texture); 	// out of memory, draw what we have
+				if (!__gui_reserve_geometry(4, 6)) return;
+			}
+			float x = c->rect.x, y = c->rect.y, w = c->rect.w, h = c->rect.h;
+			float u0 = c->src.x, v0 = c->src.y, u1 = c->src.w, v1 = c->src.h;
+
+			SDL_Vertex *v = &vertices[vertex_count];
+			v[0] = (SDL_Vertex){ { x, y }, c->color, { u0, v0 } };
+			v[1] = (SDL_Vertex){ { x + w, y }, c->color, { u1, v0 } };
+			v[2] = (SDL_Vertex){ { x + w, y + h }, c->color, { u1, v1 } };
+			v[3] = (SDL_Vertex){ { x, y + h }, c->color, { u0, v1 } };
+
+			int *ix = &indices[index_count];
+			int base = vertex_count;
+			ix[0] = base; ix[1] = base + 1; ix[2] = base + 2;
+			ix[3] = base; ix[4] = base + 2; ix[5] = base + 3;
+
+			vertex_count += 4;
+			index_count += 6;
+			quad_count++;
+			stats.pixels += (Uint64)(w * h + 0.5f);
+		} else if (c->type == GUI_CMD_MESH) {
+			const GUI_Mesh *m = c->mesh;
+			if (!__gui_reserve_geometry(m->vertex_count, m->index_count)) {
+				__gui_submit_geometry(renderer, run->texture);
+				if (!__gui_reserve_geometry(m->vertex_count, m->index_count)) return;
+			}
+
+			// move the mesh into place and tint it, vertex alpha holds the coverage
+			for (int v = 0; v < m->vertex_count; v++) {
+				SDL_Vertex *dst = &vertices[vertex_count + v];
+				*dst = m->vertices[v];
+				dst->position.x += c->rect.x;
+				dst->position.y += c->rect.y;
+				dst->color = (SDL_Color){ c->color.r, c->color.g, c->color.b, (Uint8)(c->color.a * m->vertices[v].color.a / 255) };
+			}
+			for (int ix = 0; ix < m->index_count; ix++)
+				indices[index_count + ix] = vertex_count + m->indices[ix];
+
+			vertex_count += m->vertex_count;
+			index_count += m->index_count;
+			stats.pixels += (Uint64)m->bounds.w * m->bounds.h;
+		} else {
+			SDL_Rect src = { (int)c->src.x, (int)c->src.y, (int)c->src.w, (int)c->src.h };
+			SDL_SetTextureColorMod(c->texture, c->color.r, c->color.g, c->color.b); 	// textures are shared, tint per copy
+			SDL_SetTextureAlphaMod(c->texture, c->color.a);
+			SDL_RenderCopyF(renderer, c->texture, src.w > 0 ? &src : NULL, &c->rect);
+			stats.draw_calls++;
+			stats.pixels += (Uint64)(c->rect.w * c->rect.h + 0.5f);
+		}
+	}
+}
+
+// keep the commands of this frame for GUI_GetCapturedFrame()
+static void __gui_capture_commands() {
+	if (!capture_enabled || replaying_capture) return;
+	if (!__gui_reserve((void **)&captured, &captured_cap, captured_count + command_count, sizeof(GUI_DrawCommand), MIN_COMMANDS))
+		return;
+
+	SDL_memcpy(&captured[captured_count], commands, sizeof(GUI_DrawCommand) * command_count);
+	captured_count += command_count;
+}
+
+/* Command interface */
+
+// replay everything recorded so far, required before drawing or changing renderer state directly
+void __gui_batch_flush() {
+	if (command_count == 0) return;
+
+	SDL_Renderer *renderer = GUI_GetRenderer();
+	__gui_capture_commands();
+	stats.commands += command_count;
+
+	// clip set by the caller (e.g. a damaged region), pushed clips are intersected with it
+	SDL_Rect base_clip;
+	SDL_bool clipped = SDL_RenderIsClipEnabled(renderer);
+	SDL_RenderGetClipRect(renderer, &base_clip);
+
+	int run_count = __gui_build_runs(clipped ? &base_clip : NULL);
+	if (run_count < 0) { 	// out of memory, drop the recorded commands
+		command_count = 0;
+		return;
+	}
+	__gui_sort_runs(run_count);
+
+	int clip = 0;
+	for (int r = 0; r < run_count; r++) {
+		GUI_CommandRun *run = &runs[r];
+		GUI_CommandRun *prev = r ? &runs[r - 1] : NULL;
+
+		// quads of one state go out in a single call
+		if (prev && __gui_run_state_differs(prev, run))
+			__gui_submit_geometry(renderer, prev->texture);
+
+		if (run->clip != clip) {
+			clip = run->clip;
+			SDL_RenderSetClipRect(renderer, clip ? &clips[clip] : clipped ? &base_clip : NULL);
+		}
+		__gui_replay_run(renderer, run);
+	}
+	if (run_count) __gui_submit_geometry(renderer, runs[run_count - 1].texture);
+
+	if (clip != 0) SDL_RenderSetClipRect(renderer, clipped ? &base_clip : NULL);
+	command_count = 0;
+}
+
+// record a quad, texture coordinates are normalized (ignored for colored quads)
+void __gui_batch_quad(SDL_Texture *texture, float x, float y, float w, float h, float u0, float v0, float u1, float v1, SDL_Color color) {
+	GUI_DrawCommand *c = __gui_record(GUI_CMD_QUAD);
+	if (!c) return;
+
+	c->texture = texture;
+	c->rect = (SDL_FRect){ x, y, w, h };
+	c->src = (SDL_FRect){ u0, v0, u1, v1 };
+	c->color = color;
+}
+
+// a primitive has been recorded: outside of a frame it's drawn right away
+void __gui_batch_done() {
+	if (frame_depth == 0) __gui_batch_flush();
+}
+
+// record everything until the matching __gui_batch_end() (calls nest)
+void __gui_batch_begin() {
+	if (frame_depth++ > 0) return;
+
+	stats = (GUI_RenderStats){0};
+	if (!replaying_capture) captured_count = 0;
+}
+
+void __gui_batch_end() {
+	if (frame_depth > 0 && --frame_depth == 0) __gui_batch_flush();
+}
+
+// replacements for SDL_SetRenderDrawColor() and SDL_RenderFillRect(), use with the SET_COLOR_* macros
+void __gui_set_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+	draw_color = (SDL_Color){ r, g, b, a };
+}
+
+SDL_Color __gui_get_color() {
+	return draw_color;
+}
+
+void __gui_fill_rect(const SDL_Rect *rect) {
+	if (!rect || rect->w <= 0 || rect->h <= 0) return;
+
+	__gui_batch_quad(NULL, (float)rect->x, (float)rect->y, (float)rect->w, (float)rect->h, 0, 0, 0, 0, draw_color);
+	__gui_batch_done();
+}
+
+// fill the part of 'rect' outside of 'hole' (up to four strips), for regions that get covered anyway
+void __gui_fill_rect_around(const SDL_Rect *rect, const SDL_Rect *hole) {
+	if (!rect) return;
+
+	SDL_Rect inner;
+	if (!hole || !SDL_IntersectRect(rect, hole, &inner)) {
+		__gui_fill_rect(rect);
+		return;
+	}
+
+	int right = rect->x + rect->w, bottom = rect->y + rect->h;
+	SDL_Rect strips[4] = {
+		{ rect->x, rect->y, rect->w, inner.y - rect->y }, 							// above
+		{ rect->x, inner.y + inner.h, rect->w, bottom - (inner.y + inner.h) }, 		// below
+		{ rect->x, inner.y, inner.x - rect->x, inner.h }, 							// left
+		{ inner.x + inner.w, inner.y, right - (inner.x + inner.w), inner.h } 		// right
+	};
+	for (int i = 0; i < 4; i++)
+		__gui_fill_rect(&strips[i]); 	// empty strips are skipped
+}
+
+// record a cached mesh (primitives.c) at x, y in the current color
+void __gui_batch_mesh(const GUI_Mesh *mesh, float x, float y) {
+	GUI_DrawCommand *c = __gui_record(GUI_CMD_MESH);
+	if (!c) return;
+
+	c->mesh = mesh;
+	c->rect = (SDL_FRect){ x, y, 0, 0 };
+	c->color = draw_color;
+	__gui_batch_done();
+}
+
+// SDL_RenderCopy() as a command (dst NULL: the whole target), tinted with 'color' (white: as is)
+void __gui_render_copy(SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst, SDL_Color color) {
+	if (!texture) return;
+
+	GUI_DrawCommand *c = __gui_record(GUI_CMD_COPY);
+	if (!c) return;
+
+	int w = 0, h = 0;
+	if (!dst) SDL_GetRendererOutputSize(GUI_GetRenderer(), &w, &h);
+
+	c->texture = texture;
+	c->rect = dst ? (SDL_FRect){ (float)dst->x, (float)dst->y, (float)dst->w, (float)dst->h } : (SDL_FRect){ 0, 0, (float)w, (float)h };
+	if (src) c->src = (SDL_FRect){ (float)src->x, (float)src->y, (float)src->w, (float)src->h };
+	c->color = color;
+	__gui_batch_done();
+}
+
+// restrict drawing to 'rect' (within the current clip) until the matching pop
+void __gui_push_clip(const SDL_Rect *rect) {
+	GUI_DrawCommand *c = __gui_record(GUI_CMD_PUSH_CLIP);
+	if (c && rect) c->rect = (SDL_FRect){ (float)rect->x, (float)rect->y, (float)rect->w, (float)rect->h };
+}
+
+void __gui_pop_clip() {
+	__gui_record(GUI_CMD_POP_CLIP);
+	__gui_batch_done();
+}
+
+// recorded commands may still refer to a texture, destroy textures through this
+void __gui_destroy_texture(SDL_Texture *texture) {
+	if (!texture) return;
+
+	__gui_batch_flush();
+	__gui_count_texture(texture, 0);
+	SDL_DestroyTexture(texture);
+}
+
+// release the buffers (GUI_Quit)
+void __gui_batch_quit() {
+	__gui_free(commands);
+	__gui_free(runs);
+	__gui_free(command_clip);
+	__gui_free(vertices);
+	__gui_free(indices);
+	__gui_free(captured);
+	commands = NULL;
+	runs = NULL;
+	command_clip = NULL;
+	vertices = NULL;
+	indices = NULL;
+	captured = NULL;
+	command_count = command_cap = run_cap = command_clip_cap = 0;
+	vertex_count = vertex_cap = index_count = index_cap = quad_count = 0;
+	captured_count = captured_cap = 0;
+	frame_depth = 0;
+}
+
+// visibility test result of an element (GUI_RenderElements)
+void __gui_count_element(int drawn, int occluded) {
+	if (drawn) stats.elements_drawn++;
+	else if (occluded) stats.elements_occluded++;
+	else stats.elements_culled++;
+}
+
+/* Functions for use by end user */
+
+// renderer submissions of the last GUI_RenderElements() call
+void GUI_GetRenderStats(GUI_RenderStats *out) {
+	if (out) *out = stats;
+}
+
+// keep the recorded commands of every GUI_RenderElements() call (for profiling, diffing or replaying);
+// a frame drawn into element caches or the retained target spans several targets, capture in immediate mode
+void GUI_SetFrameCapture(int enable) {
+	capture_enabled = enable;
+	if (!enable) captured_count = 0;
+}
+
+// commands of the last captured frame in recorded order, valid until the next frame is rendered
+const GUI_DrawCommand *GUI_GetCapturedFrame(int *count) {
+	if (count) *count = captured_count;
+	return captured_count ? captured : NULL;
+}
+
+// draw the last captured frame again without running any widget code
+// (the textures it refers to must still exist, so replay before elements or fonts change)
+void GUI_ReplayCapturedFrame() {
+	if (captured_count == 0) return;
+
+	replaying_capture = 1;
+	__gui_batch_begin();
+	for (int i = 0; i < captured_count; i++) {
+		GUI_DrawCommand *c = __gui_record(captured[i].type);
+		if (c) *c = captured[i];
+	}
+	__gui_batch_end();
+	replaying_capture = 0;
+}
@@ -4,7 +4,13 @@ CLS
 set COMPILER=tcc
 
 :: Compile the library (guilib.dll)
-%COMPILER% -shared -o guilib.dll guilib.c scrollbar.c label.c button.c slider.c input.c checkbox.c radiobutton.c progressbar.c listbox.c -L. -Iinclude -lSDL2 -lSDL2_ttf -lSDL2_gfx -DBUILD_GUILIB
+%COMPILER% -shared -o guilib.dll guilib.c loop.c scheduler.c pool.c hittest.c spatial.c batch.c primitives.c sprites.c font.c text.c textcache.c scrollbar.c label.c button.c slider.c input.c checkbox.c radiobutton.c progressbar.c listbox.c -L. -Iinclude -lSDL2 -lSDL2_ttf -DBUILD_GUILIB
+
+:: End script on error
+IF %ERRORLEVEL% NEQ 0 exit /b %ERRORLEVEL%
+
+:: Compile the font baker (fontbake.exe)
+%COMPILER% -o fontbake.exe fontbake.c -L. -Iinclude -lSDL2 -lSDL2_ttf
 
 :: End script on error
 IF %ERRORLEVEL% NEQ 0 exit /b %ERRORLEVEL%
@@ -1,6 +1,4 @@
-#include <stdlib.h> // malloc
 #include <stdio.h>  // printf
-#include <string.h> // strncpy, strlen
 #include "guilib.h"
 #include "defs.h"
 
@@ -8,15 +6,16 @@
 #define BUTTON_HEIGHT 		22
 #define BORDER_WIDTH 		1
 #define TEXT_SIZE 			12
+#define TEXT_PADDING 		2 		// space kept free between text and borders
 
 // TODO:
 // custom font support
-// rounded corners - https://sdl-draw.sourceforge.net/
 
 static void __gui_process_button(SDL_Event *event, GUI_Button *button, int mx, int my);
 
 GUI_Button *GUI_CreateButton(int x, int y, const char *text, void (*on_click)(void*)) {
-	GUI_Button *b = malloc(sizeof(GUI_Button));
+	GUI_Button *b = __gui_alloc_element(GUI_BUTTON);
+	if (!b) return NULL;
 
 	*b = (GUI_Button){
 		.tag = NULL,
@@ -30,6 +29,7 @@ GUI_Button *GUI_CreateButton(int x, int y, const char *text, void (*on_click)(vo
 		.hovered = 0,
 		.pressed = 0,
 		.text_size = TEXT_SIZE,
+		.corner_radius = 0,
 		.text = text,
 		.on_click = on_click,
 		.args = NULL
@@ -43,56 +43,52 @@ GUI_Button *GUI_CreateButton(int x, int y, const char *text, void (*on_click)(vo
 void GUI_RenderButton(GUI_Button *button) {
 	if (!button || !button->visible) return; // in case a NULL pointer gets passed or buttin is hidden
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
 	// button body
 	SDL_Rect button_rect = { button->x, button->y, button->width, button->height };
 
-	__gui_draw_borders(button->x, button->y, button->width, button->height, button->border_width);
+	// borders are drawn around the body with the corners rounded on both
+	if (button->corner_radius > 0) {
+		__gui_set_color(SET_COLOR_BORDER);
+		__gui_draw_rounded_border(&button_rect, button->corner_radius, button->border_width);
+	} else {
+		__gui_draw_borders(button->x, button->y, button->width, button->height, button->border_width);
+	}
 
 	// set button color
 	if (!button->enabled)
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_DISABLED);
+		__gui_set_color(SET_COLOR_DISABLED);
 	else if (button->pressed)
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_ACTIVE);
+		__gui_set_color(SET_COLOR_ACTIVE);
 	else if (button->hovered)
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_FOCUS);
+		__gui_set_color(SET_COLOR_FOCUS);
 	else
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_NORMAL);
+		__gui_set_color(SET_COLOR_NORMAL);
 
 	// render the button
-	SDL_RenderFillRect(renderer, &button_rect);
+	if (button->corner_radius > 0)
+		__gui_fill_rounded_rect(&button_rect, button->corner_radius);
+	else
+		__gui_fill_rect(&button_rect);
 
 	// render button text
 	if (button->text) {
 		// set text color
 		SDL_Color text_color = button->enabled ? current_theme->text_enabled : current_theme->text_disabled;
 
-		// if text is too long, truncate it
-		char truncated_text[32];
-		strncpy(truncated_text, button->text, sizeof(truncated_text) - 1);
-		truncated_text[sizeof(truncated_text) - 1] = '\0'; // include null-terminator
-
-		int text_width, text_height;
-		TTF_SizeText(default_font, truncated_text, &text_width, &text_height);
+		GUI_Font *font = GUI_GetFont();
 
 		// if the text is too tall, don't render it at all
-		if (text_height > button->height) return;
+		if (!font || font->height > button->height) return;
 
-		// keep removing one character from the end untl the text fits inside the button
-		while (text_width > button->width && truncated_text[0]) {
-			truncated_text[strlen(truncated_text) - 1] = '\0';
-			TTF_SizeText(default_font, truncated_text, &text_width, &text_height);
-		}
+		// if text is too long, cut it short with an ellipsis
+		GUI_TextFit fit = __gui_text_fit(font, button->text, button->width - 2 * TEXT_PADDING);
 	
 		// render text
-		if (text_width > 0) {
-			SDL_Rect text_rect = {
-				button->x + (button->width - text_width) / 2,  // center text within the button
-				button->y + (button->height - text_height) / 2,
-				text_width, text_height
-			};
-			__gui_render_text(truncated_text, &text_rect, text_color);
+		if (fit.width > 0) {
+			__gui_text_draw_fit(font, button->text, &fit,
+				button->x + (button->width - fit.width) / 2, 	// center text within the button
+				button->y + (button->height - font->height) / 2,
+				text_color);
 		}
 	}
 }
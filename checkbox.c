@@ -1,5 +1,3 @@
-#include <stdlib.h> // malloc
-#include <SDL2/SDL2_gfxPrimitives.h>
 #include "guilib.h"
 #include "defs.h"
 
@@ -11,7 +9,8 @@
 static void __gui_process_checkbox(SDL_Event *event, GUI_Checkbox *checkbox, int mx, int my);
 
 GUI_Checkbox *GUI_CreateCheckbox(int x, int y) {
-	GUI_Checkbox *c = malloc(sizeof(GUI_Checkbox));
+	GUI_Checkbox *c = __gui_alloc_element(GUI_CHECKBOX);
+	if (!c) return NULL;
 
     *c = (GUI_Checkbox){
 		.tag = NULL,
@@ -34,28 +33,13 @@ GUI_Checkbox *GUI_CreateCheckbox(int x, int y) {
 static void __gui_render_checkmark(GUI_Checkbox *checkbox) {
 	if (!checkbox) return;
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
-	int x = checkbox->x;
-	int y = checkbox->y;
-
-	// coordinates of the two lines that form the checkmark (TODO/temp: switch to center points)
-	int x1 = x + 3;
-	int y1 = y + 9;
-	int x2 = x + 7;
-	int y2 = y + 12;
-	int x3 = x + 12;
-	int y3 = y + 4;
-	
-	aalineRGBA(renderer, x1, y1, x2, y2, SET_COLOR_TEXT_ENABLED); // (SDL2_gfx)
-	aalineRGBA(renderer, x2, y2, x3, y3, SET_COLOR_TEXT_ENABLED);
+	__gui_set_color(SET_COLOR_TEXT_ENABLED);
+	__gui_draw_sprite(GUI_SPRITE_CHECKMARK, 0, checkbox->x, checkbox->y); 	// (sprites.c)
 }
 
 void GUI_RenderCheckbox(GUI_Checkbox *checkbox) {
 	if (!checkbox || !checkbox->visible) return; // NULL pointer or hidden element
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
 	// checkbox body
 	SDL_Rect checkbox_rect = { checkbox->x, checkbox->y, checkbox->width, checkbox->height };
 
@@ -63,14 +47,14 @@ void GUI_RenderCheckbox(GUI_Checkbox *checkbox) {
 
 	// apply color
 	if (!checkbox->enabled)
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_DISABLED);
+		__gui_set_color(SET_COLOR_DISABLED);
 	else if (checkbox->focus)
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_FOCUS);
+		__gui_set_color(SET_COLOR_FOCUS);
 	else
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_NORMAL);
+		__gui_set_color(SET_COLOR_NORMAL);
 
 	// render the checkbox
-	SDL_RenderFillRect(renderer, &checkbox_rect);
+	__gui_fill_rect(&checkbox_rect);
 
 	// render the checkmark
 	if (checkbox->selected)
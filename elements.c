@@ -77,6 +77,7 @@ void InitElementList(void) {
 	// button to toggle between light and dark modes
 	button3 = GUI_CreateButton(offset_x + button1->width + 10, button1->y, "Light mode", SwitchMode);
 	button3->tag = "button";
+	button3->corner_radius = 4; 	// rounded corners
 
 	// example sliders: one of a short range and one of a long range
 	// includes examples of snappy and smooth knob movement
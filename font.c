@@ -0,0 +1,298 @@
+/*
+	Font registry. Fonts are shared between elements: opening
+	the same file at the same point size hands out the already
+	loaded font and bumps its reference count. The font is
+	closed when the last reference is released.
+
+	In SDF mode (GUI_SetSDFText) every typeface is loaded
+	once at a base size with distance field glyphs, and each
+	requested size is a lightweight handle that scales it.
+
+	Baked fonts (see fontbake.c) are memory-mapped and stand
+	in for a font file at the size they were baked at, so
+	opening that font never loads it with FreeType.
+*/
+
+#include <stdio.h>  // printf
+#include <string.h> // strcmp
+#ifdef _WIN32
+#include <windows.h> // CreateFileMapping, MapViewOfFile
+#else
+#include <fcntl.h>    // open
+#include <unistd.h>   // close
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#endif
+#include <SDL2/SDL_ttf.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define DEFAULT_FONT_SIZE 	12
+#define SDF_BASE_SIZE 		48 	// size the distance field glyphs are rasterized at
+#define MAX_PENDING_BAKED 	8 	// baked fonts added before GUI_Init
+
+static GUI_Font *fonts = NULL; 			// every loaded font
+static GUI_Font *default_font = NULL; 	// library-wide font used by the widgets
+static int sdf_enabled = 0; 			// fonts opened from now on use distance field glyphs
+static int fonts_ready = 0; 			// GUI_Init has loaded the default font
+
+static struct {
+	char *baked_path, *font_path;
+} pending_baked[MAX_PENDING_BAKED];
+static int pending_count = 0;
+
+static GUI_Font *__gui_find_font(const char *path, int size, int sdf, int sized_view) {
+	for (GUI_Font *f = fonts; f; f = f->next) {
+		if (f->size == size && f->sdf == sdf && (f->base != NULL) == sized_view && strcmp(f->path, path) == 0)
+			return f;
+	}
+	return NULL;
+}
+
+static GUI_Font *__gui_add_font(const char *path, int size, TTF_Font *ttf, GUI_Font *base) {
+	GUI_Font *f = __gui_calloc(1, sizeof(GUI_Font), GUI_MEM_TEXT);
+	char *path_copy = __gui_strdup(path, GUI_MEM_STRINGS);
+	if (!f || !path_copy) {
+		__gui_free(f);
+		__gui_free(path_copy);
+		return NULL;
+	}
+	*f = (GUI_Font){
+		.path = path_copy,
+		.size = size,
+		.refs = 1,
+		.height = ttf ? TTF_FontHeight(ttf) : base ? (int)(base->height * ((float)size / base->size) + 0.5f) : 0,
+		.sdf = ttf ? (int)TTF_GetFontSDF(ttf) : base ? base->sdf : 0,
+		.scale = base ? (float)size / base->size : 1.0f,
+		.ttf = ttf,
+		.lock = ttf ? SDL_CreateMutex() : NULL,
+		.base = base,
+		.atlas = NULL,
+		.next = fonts
+	};
+	fonts = f;
+	return f;
+}
+
+// load a typeface with distance field glyphs at the base size (shared by all SDF sizes of that file)
+static GUI_Font *__gui_open_sdf_base(const char *path) {
+	GUI_Font *f = __gui_find_font(path, SDF_BASE_SIZE, 1, 0);
+	if (f) {
+		f->refs++;
+		return f;
+	}
+
+	TTF_Font *ttf = TTF_OpenFont(path, SDF_BASE_SIZE);
+	if (!ttf) {
+		printf("\n[!] Failed to load font: %s\n", TTF_GetError());
+		return NULL;
+	}
+	TTF_SetFontSDF(ttf, SDL_TRUE);
+
+	f = __gui_add_font(path, SDF_BASE_SIZE, ttf, NULL);
+	if (!f) TTF_CloseFont(ttf);
+	return f;
+}
+
+// open a font, or share the one that is already loaded from the same file at the same size
+GUI_Font *GUI_OpenFont(const char *path, int size) {
+	if (!path || size <= 0) return NULL;
+
+	GUI_Font *f = __gui_find_font(path, size, sdf_enabled, sdf_enabled);
+	if (f) {
+		f->refs++;
+		return f;
+	}
+
+	// SDF: a handle that scales the shared typeface, no new glyphs are rasterized
+	if (sdf_enabled) {
+		GUI_Font *base = __gui_open_sdf_base(path);
+		if (!base) return NULL;
+
+		f = __gui_add_font(path, size, NULL, base);
+		if (!f) GUI_CloseFont(base);
+		return f;
+	}
+
+	TTF_Font *ttf = TTF_OpenFont(path, size);
+	if (!ttf) {
+		printf("\n[!] Failed to load font: %s\n", TTF_GetError());
+		return NULL;
+	}
+
+	f = __gui_add_font(path, size, ttf, NULL);
+	if (!f) TTF_CloseFont(ttf);
+	return f;
+}
+
+static void __gui_free_font(GUI_Font *font) {
+	__gui_text_release_font(font); 	// glyph atlas and cached strings belong to the font
+	__gui_text_cache_release_font(font);
+
+	if (font->ttf) TTF_CloseFont(font->ttf);
+	if (font->lock) SDL_DestroyMutex(font->lock);
+	__gui_free(font->path);
+	__gui_free(font);
+}
+
+// release one reference to a font, the font is closed once it's no longer in use
+void GUI_CloseFont(GUI_Font *font) {
+	if (!font || --font->refs > 0) return;
+
+	GUI_Font **link = &fonts;
+	while (*link && *link != font) link = &(*link)->next;
+	if (*link) *link = font->next;
+
+	if (font == default_font) default_font = NULL;
+
+	GUI_Font *base = font->base;
+	__gui_free_font(font);
+	GUI_CloseFont(base); 	// SDF sizes hold a reference to their typeface
+}
+
+/* Baked fonts */
+
+// map a whole file into memory read-only, returns NULL on failure
+static const Uint8 *__gui_map_file(const char *path, size_t *size) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return NULL;
+
+	LARGE_INTEGER file_size;
+	HANDLE mapping = NULL;
+	const Uint8 *data = NULL;
+
+	if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping) data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (mapping) CloseHandle(mapping); 	// the view keeps the mapping alive
+	CloseHandle(file);
+
+	*size = data ? (size_t)file_size.QuadPart : 0;
+	return data;
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return NULL;
+
+	struct stat st;
+	void *data = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+		data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); 	// the mapping stays valid
+
+	if (data == MAP_FAILED) return NULL;
+	*size = st.st_size;
+	return data;
+#endif
+}
+
+static void __gui_unmap_file(const Uint8 *data, size_t size) {
+#ifdef _WIN32
+	(void)size;
+	UnmapViewOfFile(data);
+#else
+	munmap((void *)data, size);
+#endif
+}
+
+// map a baked font and register it in place of font_path at its baked size
+static GUI_Font *__gui_load_baked_font(const char *baked_path, const char *font_path) {
+	size_t size;
+	const Uint8 *data = __gui_map_file(baked_path, &size);
+	if (!data) {
+		printf("\n[!] Failed to open baked font: %s\n", baked_path);
+		return NULL;
+	}
+
+	const GUI_BakedHeader *header = (const GUI_BakedHeader *)data;
+	GUI_Font *f = NULL;
+
+	if (size < sizeof(GUI_BakedHeader) || header->size <= 0) {
+		printf("\n[!] Invalid baked font: %s\n", baked_path);
+	} else if (__gui_find_font(font_path, header->size, 0, 0)) {
+		printf("\n[!] Font %s is already loaded at size %d, baked font not used: %s\n", font_path, header->size, baked_path);
+	} else {
+		f = __gui_add_font(font_path, header->size, NULL, NULL);
+		if (f) {
+			f->height = header->height;
+			if (!__gui_text_load_baked(f, data, size)) {
+				fonts = f->next;
+				__gui_free(f->path);
+				__gui_free(f);
+				f = NULL;
+			}
+		}
+		if (!f) printf("\n[!] Invalid baked font: %s\n", baked_path);
+	}
+
+	// the atlas and metrics have been copied into the font, the file is no longer needed
+	__gui_unmap_file(data, size);
+	return f;
+}
+
+// use a baked font instead of loading font_path with FreeType at the size it was baked at
+// (call before GUI_Init to replace the default font); returns 0 on failure
+// text is drawn from the baked atlas as is, label styles (bold, italic, ...) don't apply to it
+int GUI_AddBakedFont(const char *baked_path, const char *font_path) {
+	if (!baked_path || !font_path) return 0;
+
+	if (fonts_ready) return __gui_load_baked_font(baked_path, font_path) != NULL;
+
+	// no renderer yet, load it together with the default font
+	if (pending_count == MAX_PENDING_BAKED) return 0;
+	pending_baked[pending_count].baked_path = __gui_strdup(baked_path, GUI_MEM_STRINGS);
+	pending_baked[pending_count].font_path = __gui_strdup(font_path, GUI_MEM_STRINGS);
+	pending_count++;
+	return 1;
+}
+
+// library-wide default font, borrowed: no reference is taken, don't pass it to GUI_CloseFont
+// (GUI_OpenFont it by path and size for a reference of your own)
+GUI_Font *GUI_GetFont() {
+	return default_font;
+}
+
+// draw text of fonts opened from now on from one distance field atlas per typeface,
+// every size and scale then shares the same glyphs (call before GUI_Init to include the default font);
+// label styles (bold, italic, ...) don't apply to text drawn from the atlas
+void GUI_SetSDFText(int enable) {
+	sdf_enabled = enable;
+}
+
+/* Functions for in-library use only */
+
+int __gui_font_init() {
+	// the registry holds the only reference to baked fonts, they stay loaded until GUI_Quit
+	for (int i = 0; i < pending_count; i++) {
+		if (pending_baked[i].baked_path && pending_baked[i].font_path)
+			__gui_load_baked_font(pending_baked[i].baked_path, pending_baked[i].font_path);
+		__gui_free(pending_baked[i].baked_path);
+		__gui_free(pending_baked[i].font_path);
+	}
+	pending_count = 0;
+	fonts_ready = 1;
+
+	default_font = GUI_OpenFont(LIBERATION_SANS, DEFAULT_FONT_SIZE);
+	return default_font != NULL;
+}
+
+// serialize SDL_ttf calls on a font between the render thread and the text workers
+void __gui_font_lock(GUI_Font *font) {
+	if (font && font->lock) SDL_LockMutex(font->lock);
+}
+
+void __gui_font_unlock(GUI_Font *font) {
+	if (font && font->lock) SDL_UnlockMutex(font->lock);
+}
+
+// close every font regardless of how many references are left
+void __gui_font_quit() {
+	while (fonts) {
+		GUI_Font *f = fonts;
+		fonts = f->next;
+		__gui_free_font(f);
+	}
+	default_font = NULL;
+	fonts_ready = 0;
+}
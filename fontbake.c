@@ -0,0 +1,214 @@
+/*
+	Offline font baker. Rasterizes a set of glyphs of a font
+	at one point size into an alpha atlas and writes it to
+	a file together with advances, kerning pairs and line
+	height (layout in guilib.h, see GUI_BakedHeader).
+
+	The library loads the result with GUI_AddBakedFont()
+	and never has to open the font with FreeType.
+
+	Usage: fontbake <font.ttf> <size> <output> [first-last ...]
+	Code point ranges default to Latin-1 and the ellipsis.
+*/
+
+#define SDL_MAIN_HANDLED // required by MinGW on Windows to prevent SDL2 from redefining main()
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdlib.h> // malloc, calloc, realloc, free, strtoul
+#include <stdio.h>  // printf, fopen, fwrite
+#include <string.h> // memcpy
+#include "guilib.h"
+
+#define ATLAS_WIDTH 		512
+#define GLYPH_PADDING 		1 		// same spacing as the runtime atlas (text.c)
+#define MAX_RANGES 			32
+
+typedef struct {
+	Uint32 first, last;
+} Range;
+
+static Range default_ranges[] = {
+	{ 0x20, 0x7E }, 		// ASCII
+	{ 0xA0, 0xFF }, 		// Latin-1 supplement
+	{ 0x2026, 0x2026 } 		// ellipsis, used when text is cut short
+};
+
+static int parse_range(const char *arg, Range *range) {
+	char *end;
+	range->first = strtoul(arg, &end, 0);
+	range->last = range->first;
+	if (*end == '-') range->last = strtoul(end + 1, &end, 0);
+	return *end == '\0' && range->first <= range->last && range->last <= 0x10FFFF;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 4) {
+		printf("usage: %s <font.ttf> <size> <output> [first-last ...]\n", argv[0]);
+		return 1;
+	}
+
+	Range ranges[MAX_RANGES];
+	int range_count = 0;
+
+	for (int i = 4; i < argc && range_count < MAX_RANGES; i++) {
+		if (!parse_range(argv[i], &ranges[range_count])) {
+			printf("\n[!] Invalid code point range: %s\n", argv[i]);
+			return 1;
+		}
+		range_count++;
+	}
+	if (range_count == 0) {
+		range_count = sizeof(default_ranges) / sizeof(default_ranges[0]);
+		memcpy(ranges, default_ranges, sizeof(default_ranges));
+	}
+
+	int size = atoi(argv[2]);
+	if (size <= 0 || TTF_Init() != 0) {
+		printf("\n[!] Invalid size or failed to initialize SDL_ttf\n");
+		return 1;
+	}
+
+	TTF_Font *font = TTF_OpenFont(argv[1], size);
+	if (!font) {
+		printf("\n[!] Failed to load font: %s\n", TTF_GetError());
+		return 1;
+	}
+
+	GUI_BakedGlyph *glyphs = NULL;
+	SDL_Surface **images = NULL;
+	int glyph_count = 0, glyph_cap = 0;
+
+	// shelf packing, the same way the runtime atlas is filled
+	int shelf_x = 0, shelf_y = 0, shelf_h = 0;
+	SDL_Color white = { 255, 255, 255, 255 };
+
+	for (int r = 0; r < range_count; r++) {
+		for (Uint32 ch = ranges[r].first; ch <= ranges[r].last; ch++) {
+			if (!TTF_GlyphIsProvided32(font, ch)) continue;
+
+			int minx = 0, advance = 0;
+			if (TTF_GlyphMetrics32(font, ch, &minx, NULL, NULL, NULL, &advance) != 0) continue;
+
+			if (glyph_count == glyph_cap) {
+				glyph_cap = glyph_cap ? glyph_cap * 2 : 256;
+				glyphs = realloc(glyphs, sizeof(GUI_BakedGlyph) * glyph_cap);
+				images = realloc(images, sizeof(SDL_Surface *) * glyph_cap);
+				if (!glyphs || !images) {
+					printf("\n[!] Out of memory\n");
+					return 1;
+				}
+			}
+
+			GUI_BakedGlyph *g = &glyphs[glyph_count];
+			*g = (GUI_BakedGlyph){ ch, advance, minx < 0 ? minx : 0, 0, 0, 0, 0 };
+
+			// whitespace has nothing to draw
+			SDL_Surface *image = TTF_RenderGlyph32_Blended(font, ch, white);
+			if (image && (image->w == 0 || image->h == 0)) {
+				SDL_FreeSurface(image);
+				image = NULL;
+			}
+			if (image) {
+				SDL_Surface *converted = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_ARGB8888, 0);
+				SDL_FreeSurface(image);
+				image = converted;
+			}
+
+			if (image) {
+				if (shelf_x + image->w + GLYPH_PADDING > ATLAS_WIDTH) {
+					shelf_y += shelf_h + GLYPH_PADDING;
+					shelf_x = shelf_h = 0;
+				}
+				g->x = shelf_x;
+				g->y = shelf_y;
+				g->w = image->w;
+				g->h = image->h;
+
+				shelf_x += image->w + GLYPH_PADDING;
+				if (image->h > shelf_h) shelf_h = image->h;
+			}
+			images[glyph_count++] = image;
+		}
+	}
+
+	// kerning of every pair of baked glyphs, only non-zero pairs are stored
+	GUI_BakedKerning *kerning = NULL;
+	int kerning_count = 0, kerning_cap = 0;
+
+	if (TTF_GetFontKerning(font)) {
+		for (int a = 0; a < glyph_count; a++) {
+			for (int b = 0; b < glyph_count; b++) {
+				int k = TTF_GetFontKerningSizeGlyphs32(font, glyphs[a].ch, glyphs[b].ch);
+				if (k == 0) continue;
+
+				if (kerning_count == kerning_cap) {
+					kerning_cap = kerning_cap ? kerning_cap * 2 : 256;
+					kerning = realloc(kerning, sizeof(GUI_BakedKerning) * kerning_cap);
+					if (!kerning) {
+						printf("\n[!] Out of memory\n");
+						return 1;
+					}
+				}
+				kerning[kerning_count++] = (GUI_BakedKerning){ glyphs[a].ch, glyphs[b].ch, k };
+			}
+		}
+	}
+
+	// copy the alpha channel of every glyph into the atlas
+	int atlas_height = shelf_y + shelf_h;
+	Uint8 *atlas = calloc((size_t)ATLAS_WIDTH * atlas_height + 1, 1);
+	if (!atlas) {
+		printf("\n[!] Out of memory\n");
+		return 1;
+	}
+
+	for (int i = 0; i < glyph_count; i++) {
+		SDL_Surface *image = images[i];
+		if (!image) continue;
+
+		SDL_LockSurface(image);
+		for (int y = 0; y < image->h; y++) {
+			Uint32 *row = (Uint32 *)((Uint8 *)image->pixels + y * image->pitch);
+			for (int x = 0; x < image->w; x++)
+				atlas[(glyphs[i].y + y) * ATLAS_WIDTH + glyphs[i].x + x] = row[x] >> 24;
+		}
+		SDL_UnlockSurface(image);
+		SDL_FreeSurface(image);
+	}
+
+	GUI_BakedHeader header = {
+		.magic = GUI_BAKED_MAGIC,
+		.version = GUI_BAKED_VERSION,
+		.size = size,
+		.height = TTF_FontHeight(font),
+		.atlas_width = ATLAS_WIDTH,
+		.atlas_height = atlas_height,
+		.glyph_count = glyph_count,
+		.kerning_count = kerning_count
+	};
+
+	FILE *out = fopen(argv[3], "wb");
+	if (!out) {
+		printf("\n[!] Failed to open %s for writing\n", argv[3]);
+		return 1;
+	}
+	int ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+		fwrite(glyphs, sizeof(GUI_BakedGlyph), glyph_count, out) == (size_t)glyph_count &&
+		fwrite(kerning, sizeof(GUI_BakedKerning), kerning_count, out) == (size_t)kerning_count &&
+		fwrite(atlas, 1, (size_t)ATLAS_WIDTH * atlas_height, out) == (size_t)ATLAS_WIDTH * atlas_height;
+	if (fclose(out) != 0) ok = 0;
+
+	if (!ok) {
+		printf("\n[!] Failed to write %s\n", argv[3]);
+		return 1;
+	}
+	printf("%s: %d glyphs, %d kerning pairs, %dx%d atlas\n", argv[3], glyph_count, kerning_count, ATLAS_WIDTH, atlas_height);
+
+	free(glyphs);
+	free(images);
+	free(kerning);
+	free(atlas);
+	TTF_CloseFont(font);
+	TTF_Quit();
+	return 0;
+}
@@ -1,26 +1,25 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
-#include <stdlib.h> // free
+#include <stdlib.h> // qsort
 #include <stdio.h>  // printf
-#include <string.h> // free
+#include <string.h> // strcmp, strlen
+#include <stddef.h> // offsetof
 #include "guilib.h"
 #include "defs.h"
 
-#define MAX_ELEMENTS 		250
+#define MIN_ELEMENT_CAP 		64 		// initial size of the element store, doubled when full
+#define MAX_DAMAGE_RECTS 	16 		// damaged regions tracked separately before being merged into one
+#define MAX_OCCLUDERS 		8 		// opaque overlays elements below them are hidden by
 
 // TODO:
 // add more error messages on failed element creation
 // custom color support for individual elements
-// cache TTF_RenderUTF8_Blended and SDL_CreateTextureFromSurface operations
-// GetFont() instead of global variable
 // macro 'HIDDEN' to hide library-specific symbols in GCC builds (by default, all symbols are exported in GCC)
 // move library-specific symbols to a separate header file
 // replace SDL_ttf: https://github.com/grimfang4/SDL_FontCache
 // resizable elements
 // merge the two text rendering functions and automatically truncate and clip text where needed
-// replace checkmark and arrow icons (lines) with custom bitmaps (SDL_LockTexture() to draw pixels to a texture)
 
-TTF_Font *default_font = NULL;
 GUI_Theme *current_theme = NULL;
 
 static SDL_Window *GUI_Window = NULL;
@@ -28,8 +27,44 @@ static SDL_Renderer *GUI_Renderer = NULL;
 
 static int gui_initialized = 0;
 
-static GUI_Element elements[MAX_ELEMENTS];
-static int element_count = 0;
+// element store: elements in creation (= drawing) order, deleted ones leave gaps until compacted;
+// slots give every element a stable identity for handles, a pointer lookup finds elements in O(1)
+typedef struct {
+	Uint32 generation; 	// bumped when the element is deleted, older handles stop matching
+	int index, 			// position in 'elements', -1: unused
+		next_free;
+} GUI_ElementSlot;
+
+static GUI_Element *elements = NULL;
+static int element_count = 0, element_cap = 0, element_gaps = 0;
+static GUI_ElementSlot *slots = NULL;
+static int slot_count = 0, slot_cap = 0, free_slot = -1;
+static void **lookup_keys = NULL; 	// open addressing: element pointer -> slot
+static int *lookup_slots = NULL;
+static int lookup_cap = 0, lookup_count = 0;
+
+// retained mode
+static int retained_mode = 0;
+static SDL_Texture *retained_target = NULL; 	// persistent copy of the window contents
+static int target_width = 0, target_height = 0;
+static const GUI_Theme *drawn_theme = NULL; 	// theme the target was painted with
+static SDL_Color background_color = { 0, 0, 0, 255 };
+static SDL_Rect damage[MAX_DAMAGE_RECTS]; 		// regions to repaint on the next frame
+static int damage_count = 0;
+static const SDL_Rect *damage_clip = NULL; 		// region currently being repainted
+static int auto_caching = 0; 					// cache static element types without opting in each one
+
+// culling
+static SDL_Rect occluders[MAX_OCCLUDERS]; 		// opaque areas of this frame's overlays
+static int occluder_element[MAX_OCCLUDERS]; 	// index of the element that draws each of them
+static int occluder_count = 0;
+
+// pointer routing: slots of the elements that get the next pointer event wherever it happens
+// (hovered ones, to notice the cursor leaving, and ones holding capture, e.g. a dragged slider)
+static int *receivers = NULL;
+static int receiver_count = 0, receiver_cap = 0;
+static int *pointer_targets = NULL; 	// element indices the current pointer event goes to
+static int target_count = 0, target_cap = 0;
 
 static GUI_Theme dark_theme = {
     {  23,  23,  23, 255 }, 	// border color
@@ -83,6 +118,124 @@ SDL_Window *GUI_GetWindow() {
 	return GUI_Window;
 }
 
+/* Element store */
+
+static Uint32 __gui_lookup_hash(void *elem) {
+	return __gui_hash_bytes(GUI_HASH_INIT, &elem, sizeof(elem));
+}
+
+// position of an element pointer in the lookup table, -1 if it isn't registered
+static int __gui_lookup_find(void *elem) {
+	if (!elem || lookup_cap == 0) return -1;
+
+	for (int pos = __gui_lookup_hash(elem) & (lookup_cap - 1); lookup_keys[pos]; pos = (pos + 1) & (lookup_cap - 1))
+		if (lookup_keys[pos] == elem) return pos;
+	return -1;
+}
+
+static int __gui_lookup_insert(void *elem, int slot) {
+	if (__gui_lookup_find(elem) >= 0) return 0; 	// registered twice
+
+	// keep the table at most half full
+	if ((lookup_count + 1) * 2 > lookup_cap) {
+		int cap = lookup_cap ? lookup_cap * 2 : MIN_ELEMENT_CAP * 2;
+		void **keys = __gui_calloc(cap, sizeof(void *), GUI_MEM_ELEMENTS);
+		int *values = __gui_malloc(sizeof(int) * cap, GUI_MEM_ELEMENTS);
+		if (!keys || !values) {
+			printf("\n[!] Failed to grow the element lookup table to %d entries.\n", cap);
+			__gui_free(keys);
+			__gui_free(values);
+			return 0;
+		}
+		for (int i = 0; i < lookup_cap; i++) {
+			if (!lookup_keys[i]) continue;
+			int pos = __gui_lookup_hash(lookup_keys[i]) & (cap - 1);
+			while (keys[pos]) pos = (pos + 1) & (cap - 1);
+			keys[pos] = lookup_keys[i];
+			values[pos] = lookup_slots[i];
+		}
+		__gui_free(lookup_keys);
+		__gui_free(lookup_slots);
+		lookup_keys = keys;
+		lookup_slots = values;
+		lookup_cap = cap;
+	}
+
+	int pos = __gui_lookup_hash(elem) & (lookup_cap - 1);
+	while (lookup_keys[pos]) pos = (pos + 1) & (lookup_cap - 1);
+	lookup_keys[pos] = elem;
+	lookup_slots[pos] = slot;
+	lookup_count++;
+	return 1;
+}
+
+// remove an entry, moving later entries of the same probe chain back into the hole
+static void __gui_lookup_remove(int pos) {
+	int mask = lookup_cap - 1;
+	lookup_keys[pos] = NULL;
+	lookup_count--;
+
+	for (int next = (pos + 1) & mask; lookup_keys[next]; next = (next + 1) & mask) {
+		int home = __gui_lookup_hash(lookup_keys[next]) & mask;
+		// leave the entry where it is if its home lies cyclically within (pos, next]
+		if (((next - home) & mask) < ((next - pos) & mask)) continue;
+
+		lookup_keys[pos] = lookup_keys[next];
+		lookup_slots[pos] = lookup_slots[next];
+		lookup_keys[next] = NULL;
+		pos = next;
+	}
+}
+
+static GUI_Element *__gui_find_element(void *elem) {
+	int pos = __gui_lookup_find(elem);
+	return pos < 0 ? NULL : &elements[slots[lookup_slots[pos]].index];
+}
+
+// close the gaps deleted elements left, keeping the order of the others
+static void __gui_compact_elements() {
+	int count = 0;
+	for (int i = 0; i < element_count; i++) {
+		if (!elements[i].element) continue;
+		if (count != i) {
+			elements[count] = elements[i];
+			__gui_hit_move(i, count);
+		}
+		slots[elements[count].slot].index = count;
+		count++;
+	}
+	__gui_hit_truncate(count);
+	element_count = count;
+	element_gaps = 0;
+}
+
+// release the store (GUI_Quit), outstanding handles stop matching
+static void __gui_elements_quit() {
+	__gui_free(elements);
+	__gui_free(lookup_keys);
+	__gui_free(lookup_slots);
+	__gui_hit_quit();
+	__gui_spatial_quit();
+	__gui_free(receivers);
+	__gui_free(pointer_targets);
+	receivers = pointer_targets = NULL;
+	receiver_count = receiver_cap = target_count = target_cap = 0;
+	elements = NULL;
+	lookup_keys = NULL;
+	lookup_slots = NULL;
+	element_count = element_cap = element_gaps = 0;
+	lookup_cap = lookup_count = 0;
+
+	// slots survive so their generations keep counting
+	free_slot = -1;
+	for (int i = slot_count - 1; i >= 0; i--) {
+		slots[i].generation++;
+		slots[i].index = -1;
+		slots[i].next_free = free_slot;
+		free_slot = i;
+	}
+}
+
 /* Functions for use by end user */
 
 // initialize library with an existing window and renderer
@@ -96,33 +249,79 @@ int GUI_Init(SDL_Window *window, SDL_Renderer *renderer) {
 	}
 	
 	TTF_Init();  // initialize SDL2_ttf
-	default_font = TTF_OpenFont(LIBERATION_SANS, 12);
+	__gui_font_init(); 	// load the default font
 	GUI_SetTheme(DARK_MODE);
 
 	gui_initialized = 1;
 	return 1;
 }
 
-// clean up the library
+// release what an element owns besides its struct (that goes back to its pool)
 // TODO: simplify with a per-element destroy function pointer
-void GUI_Quit() {
-	// free all allocated elements
-	for (int i = 0; i < element_count; i++) {
-		// GUI_Input contains an allocated text field which requires freeing separately
-		if (elements[i].type == GUI_INPUT) {
-			GUI_Input *input = (GUI_Input *)elements[i].element;
-			free(input->text);
-		}
-		else if (elements[i].type == GUI_RADIOGROUP) {
-			GUI_RadioGroup *group = (GUI_RadioGroup *)elements[i].element;
-			free(group->buttons); 	// array of pointers to radio buttons
-		}
-		else if (elements[i].type == GUI_LISTBOX) {
-			GUI_ListBox *listbox = (GUI_ListBox *)elements[i].element;
-			free(listbox->entries); // text entries
-		}
-		free(elements[i].element);
+static void __gui_destroy_element(GUI_Element *e) {
+	if (e->type == GUI_INPUT) {
+		GUI_Input *input = (GUI_Input *)e->element;
+		GUI_CancelTimer(input->blink_timer); 	// would fire on freed memory
+		__gui_free(input->glyph_x); 			// caret positions
+		__gui_free(input->glyph_byte);
+		__gui_free(input->text);
+		__gui_free((char *)input->placeholder); 	// a trimmed copy
+	}
+	else if (e->type == GUI_RADIOGROUP) {
+		GUI_RadioGroup *group = (GUI_RadioGroup *)e->element;
+		__gui_free(group->buttons); 	// array of pointers to radio buttons
+	}
+	else if (e->type == GUI_LABEL) {
+		GUI_DestroyLabel((GUI_Label *)e->element); // cached layout and font reference
+	}
+	else if (e->type == GUI_LISTBOX) {
+		GUI_ListBox *listbox = (GUI_ListBox *)e->element;
+		__gui_free(listbox->entries); // text entries
 	}
+	else if (e->type == GUI_PROGRESSBAR) {
+		GUI_CancelTimer(((GUI_ProgressBar *)e->element)->tween);
+	}
+	if (e->cache) __gui_destroy_texture(e->cache);
+	e->cache = NULL;
+}
+
+// take an element out of the store, leaving a gap so the others keep their order
+// (and loops running right now their positions)
+static void __gui_unregister_element(GUI_Element *e) {
+	int pos = __gui_lookup_find(e->element);
+	if (pos >= 0) __gui_lookup_remove(pos);
+
+	GUI_ElementSlot *slot = &slots[e->slot];
+	slot->generation++; 	// outstanding handles stop matching
+	slot->index = -1;
+	slot->next_free = free_slot;
+	free_slot = e->slot;
+
+	__gui_hit_set((int)(e - elements), &(SDL_Rect){0}, 0);
+	__gui_spatial_remove(e->slot);
+	*e = (GUI_Element){ .element = NULL, .slot = -1, .screen = -1 };
+	element_gaps++;
+}
+
+// clean up the library
+void GUI_Quit() {
+	// free what the elements own (their structs go with the screens' pools)
+	for (int i = 0; i < element_count; i++)
+		if (elements[i].element) __gui_destroy_element(&elements[i]);
+	GUI_ClearTextCache(); 	// rendered strings
+	__gui_font_quit(); 		// fonts and their glyph atlases
+	__gui_text_cache_quit(); 	// text worker threads
+	__gui_primitives_quit(); 	// cached meshes
+	__gui_sprites_quit();
+	__gui_scheduler_quit(); 	// timers and tweens
+	__gui_batch_quit();
+	__gui_elements_quit();
+	__gui_memory_quit(); 		// element pools and the frame arena
+
+	if (retained_target) __gui_destroy_texture(retained_target);
+	retained_target = NULL;
+	damage_count = 0;
+	drawn_theme = NULL;
 	TTF_Quit();
 	SDL_DestroyRenderer(GUI_Renderer);
 	SDL_DestroyWindow(GUI_Window);
@@ -131,41 +330,689 @@ void GUI_Quit() {
 
 // delete existing element
 void GUI_DeleteElement(void *elem) {
-	for (int i = 0; i < element_count; ++i) {
-		if (elements[i].element == elem) {
-			// free allocated memory for the element
-			free(elements[i].element);
+	GUI_Element *e = __gui_find_element(elem);
+	if (!e) return;
+
+	__gui_add_damage(&e->bounds); 	// uncover whatever was below it
+	__gui_destroy_element(e);
+
+	// return the struct to its pool
+	__gui_free_element(e->type, e->screen, e->element);
+	__gui_unregister_element(e);
+}
+
+// start a new screen: elements created from now on belong to it (e.g. a dialog); returns 0 if too many are open
+int GUI_PushScreen() {
+	return __gui_screen_push() >= 0;
+}
+
+// delete every element of the top screen and free its memory in one go
+void GUI_PopScreen() {
+	int screen = __gui_current_screen();
+	if (screen == 0) {
+		printf("\n[!] No screen to pop (the base screen stays until GUI_Quit).\n");
+		return;
+	}
+
+	// a screen's elements are the last ones in the store, lower screens can't add any while it's open
+	int i = element_count - 1;
+	for (; i >= 0; i--) {
+		GUI_Element *e = &elements[i];
+		if (!e->element) continue; 	// gap
+		if (e->screen != screen) break;
+
+		__gui_add_damage(&e->bounds);
+		__gui_destroy_element(e);
+		__gui_unregister_element(e);
+	}
+
+	// drop the tail, gaps included
+	for (int j = i + 1; j < element_count; j++) element_gaps--;
+	element_count = i + 1;
+	__gui_hit_truncate(element_count);
+
+	__gui_screen_release();
+}
+
+// stable reference to an element (0 if it isn't registered)
+GUI_Handle GUI_GetHandle(void *elem) {
+	int pos = __gui_lookup_find(elem);
+	if (pos < 0) return 0;
+
+	int slot = lookup_slots[pos];
+	return ((GUI_Handle)slots[slot].generation << 32) | (Uint32)(slot + 1);
+}
+
+// element a handle refers to, NULL if it has been deleted since
+void *GUI_GetElement(GUI_Handle handle) {
+	int slot = (int)(Uint32)handle - 1;
+	if (slot < 0 || slot >= slot_count) return NULL;
+
+	GUI_ElementSlot *s = &slots[slot];
+	if (s->index < 0 || s->generation != (Uint32)(handle >> 32)) return NULL;
+	return elements[s->index].element;
+}
+
+/* Retained rendering */
+
+static SDL_Rect __gui_border_rect(int x, int y, int width, int height, int border_width) {
+	if (border_width < 0) border_width = 0;
+	return (SDL_Rect){ x - border_width, y - border_width, width + border_width * 2, height + border_width * 2 };
+}
+
+// screen area an element covers in its current state
+static SDL_Rect __gui_get_bounds(GUI_Element *elem) {
+	SDL_Rect bounds = {0};
+
+	switch (elem->type) {
+	case GUI_LABEL: {
+		GUI_Label *l = elem->element;
+		if (l->visible) bounds = (SDL_Rect){ l->x, l->y, l->width, l->height };
+		break;
+	}
+	case GUI_BUTTON: {
+		GUI_Button *b = elem->element;
+		if (b->visible) bounds = __gui_border_rect(b->x, b->y, b->width, b->height, b->border_width);
+		break;
+	}
+	case GUI_SLIDER: {
+		GUI_Slider *s = elem->element;
+		if (!s->visible) break;
+
+		// the knob may stick out of the track
+		int knob_y = s->y + (s->height / 2) - (s->knob_height / 2);
+		SDL_Rect knob = __gui_border_rect(s->pos_x, knob_y, s->knob_width, s->knob_height, s->border_width);
+		bounds = __gui_border_rect(s->x, s->y, s->width, s->height, s->border_width);
+		SDL_UnionRect(&bounds, &knob, &bounds);
+		break;
+	}
+	case GUI_INPUT: {
+		GUI_Input *in = elem->element;
+		if (in->visible) bounds = __gui_border_rect(in->x, in->y, in->width, in->height, in->border_width);
+		break;
+	}
+	case GUI_CHECKBOX: {
+		GUI_Checkbox *c = elem->element;
+		if (c->visible) bounds = __gui_border_rect(c->x, c->y, c->width, c->height, c->border_width);
+		break;
+	}
+	case GUI_RADIOBUTTON: {
+		GUI_RadioButton *rb = elem->element;
+		// drawn around (x + r, y + r - 2), one extra pixel for anti-aliasing
+		if (rb->visible) bounds = (SDL_Rect){ rb->x - 1, rb->y - 3, rb->r * 2 + 3, rb->r * 2 + 3 };
+		break;
+	}
+	case GUI_PROGRESSBAR: {
+		GUI_ProgressBar *pb = elem->element;
+		if (pb->visible) bounds = __gui_border_rect(pb->x, pb->y, pb->width, pb->height, pb->border_width);
+		break;
+	}
+	case GUI_LISTBOX: {
+		GUI_ListBox *lb = elem->element;
+		if (!lb->visible) break;
+
+		// the scrollbar of an expanded list is drawn inside its width
+		int rows = 1;
+		if (lb->expanded) rows += lb->entry_count < lb->max_visible ? lb->entry_count : lb->max_visible;
+		bounds = __gui_border_rect(lb->x, lb->y, lb->width, lb->entry_height * rows, lb->border_width);
+		break;
+	}
+	default:
+		break;
+	}
+	return bounds;
+}
+
+// what an element can be hit for, besides being visible (that follows from its bounds)
+static Uint32 __gui_hit_flags(GUI_Element *elem) {
+	if (!elem->process) return GUI_HIT_VISIBLE;
+
+	switch (elem->type) {
+	case GUI_BUTTON:
+		if (!((GUI_Button *)elem->element)->enabled) return GUI_HIT_VISIBLE;
+		break;
+	case GUI_CHECKBOX:
+		if (!((GUI_Checkbox *)elem->element)->enabled) return GUI_HIT_VISIBLE;
+		break;
+	case GUI_RADIOBUTTON:
+		if (!((GUI_RadioButton *)elem->element)->enabled) return GUI_HIT_VISIBLE;
+		break;
+	default:
+		break;
+	}
+	return GUI_HIT_VISIBLE | GUI_HIT_ENABLED;
+}
+
+// bounds of elements[index], keeping its row of the hit test table and the spatial index up to date on the way
+static SDL_Rect __gui_refresh_bounds(int index) {
+	GUI_Element *elem = &elements[index];
+	SDL_Rect bounds = __gui_get_bounds(elem);
+	__gui_hit_set(index, &bounds, __gui_hit_flags(elem));
+	if (elem->process) __gui_spatial_update(elem->slot, &bounds); 	// only what takes input is routed to
+	return bounds;
+}
+
+// hash of everything that affects how an element looks (content of in-place edited strings included)
+static Uint32 __gui_get_state(GUI_Element *elem) {
+	Uint32 hash = GUI_HASH_INIT;
+
+	switch (elem->type) {
+	case GUI_LABEL: {
+		GUI_Label *l = elem->element;
+		int pending = __gui_label_update_layout(l); 	// lines appear once their texture is uploaded
+		hash = __gui_hash_bytes(hash, &l->x, offsetof(GUI_Label, layout_hash) - offsetof(GUI_Label, x));
+		hash = __gui_hash_bytes(hash, &l->layout_hash, sizeof(l->layout_hash));
+		hash = __gui_hash_bytes(hash, &pending, sizeof(pending));
+		break;
+	}
+	case GUI_BUTTON: {
+		GUI_Button *b = elem->element;
+		hash = __gui_hash_bytes(hash, &b->x, offsetof(GUI_Button, on_click) - offsetof(GUI_Button, x));
+		if (b->text) hash = __gui_hash_bytes(hash, b->text, strlen(b->text));
+		break;
+	}
+	case GUI_SLIDER:
+		hash = __gui_hash_bytes(hash, &((GUI_Slider *)elem->element)->x, sizeof(GUI_Slider) - offsetof(GUI_Slider, x));
+		break;
+	case GUI_INPUT: {
+		GUI_Input *in = elem->element;
+		__gui_input_update_caret(in); 	// blinking is a change like any other
+		hash = __gui_hash_bytes(hash, &in->x, offsetof(GUI_Input, text) - offsetof(GUI_Input, x));
+		if (in->text) hash = __gui_hash_bytes(hash, in->text, strlen(in->text));
+		if (in->placeholder) hash = __gui_hash_bytes(hash, in->placeholder, strlen(in->placeholder));
+		break;
+	}
+	case GUI_CHECKBOX:
+		hash = __gui_hash_bytes(hash, &((GUI_Checkbox *)elem->element)->x, sizeof(GUI_Checkbox) - offsetof(GUI_Checkbox, x));
+		break;
+	case GUI_RADIOBUTTON:
+		hash = __gui_hash_bytes(hash, &((GUI_RadioButton *)elem->element)->x, offsetof(GUI_RadioButton, group) - offsetof(GUI_RadioButton, x));
+		break;
+	case GUI_PROGRESSBAR: {
+		GUI_ProgressBar *pb = elem->element;
+		__gui_progress_update(pb);
+		int filled = __gui_progress_fill(pb, pb->pos);
+		hash = __gui_hash_bytes(hash, &pb->x, offsetof(GUI_ProgressBar, pos) - offsetof(GUI_ProgressBar, x));
+		hash = __gui_hash_bytes(hash, &filled, sizeof(filled));
+		break;
+	}
+	case GUI_LISTBOX: {
+		GUI_ListBox *lb = elem->element;
+		hash = __gui_hash_bytes(hash, &lb->x, sizeof(GUI_ListBox) - offsetof(GUI_ListBox, x));
+		if (lb->placeholder) hash = __gui_hash_bytes(hash, lb->placeholder, strlen(lb->placeholder));
+		for (int i = 0; i < lb->entry_count; i++) {
+			const char *text = lb->entries[i].text;
+			if (text) hash = __gui_hash_bytes(hash, text, strlen(text) + 1); 	// terminator keeps "ab","c" apart from "a","bc"
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	return hash;
+}
+
+// elements whose render function keeps changing them (the progress bar eases towards its value)
+static int __gui_is_animating(GUI_Element *elem) {
+	if (elem->type == GUI_PROGRESSBAR) {
+		GUI_ProgressBar *pb = elem->element;
+		return pb->visible && __gui_progress_fill(pb, pb->pos) != __gui_progress_fill(pb, pb->value);
+	}
+	return 0;
+}
+
+// recompute an element's state, bumping its version if it changed; returns 1 on change
+static int __gui_update_state(GUI_Element *elem) {
+	Uint32 state = __gui_get_state(elem);
+	if (state == elem->state) return 0;
+
+	elem->state = state;
+	elem->version++;
+	return 1;
+}
+
+static void __gui_damage_all() {
+	int w = 0, h = 0;
+	if (GUI_Renderer) SDL_GetRendererOutputSize(GUI_Renderer, &w, &h);
+
+	damage_count = 0;
+	__gui_add_damage(&(SDL_Rect){ 0, 0, w, h });
+}
+
+// compare every element with how it was last drawn and mark the differences as damaged
+static void __gui_collect_damage() {
+	if (current_theme != drawn_theme) {
+		drawn_theme = current_theme;
+		__gui_damage_all();
+	}
+
+	for (int i = 0; i < element_count; i++) {
+		GUI_Element *elem = &elements[i];
+		if (!elem->element || !elem->render) continue;
+
+		int changed = __gui_update_state(elem);
+		SDL_Rect bounds = __gui_refresh_bounds(i);
+
+		if (changed || elem->animating || !SDL_RectEquals(&bounds, &elem->bounds)) {
+			__gui_add_damage(&elem->bounds); 	// where it was
+			__gui_add_damage(&bounds); 			// where it is now
+			elem->bounds = bounds;
+		}
+	}
+}
+
+/* Per-element texture cache */
+
+static int __gui_cache_wanted(GUI_Element *elem) {
+	if (elem->cache_mode == DISABLED || elem->animating) return 0;
+
+	// listboxes are only static while collapsed
+	if (elem->type == GUI_LISTBOX && ((GUI_ListBox *)elem->element)->expanded) return 0;
+	if (elem->cache_mode == ENABLED) return 1;
+
+	switch (elem->type) {
+	case GUI_LABEL:
+	case GUI_BUTTON:
+	case GUI_CHECKBOX:
+	case GUI_RADIOBUTTON:
+	case GUI_LISTBOX:
+		return auto_caching;
+	default:
+		return 0;
+	}
+}
+
+// draw an element from its cached texture, redrawing the texture first if the element changed
+// (its version, which covers the content of the strings it shows, see __gui_get_state);
+// returns 0 if the element has to be drawn directly
+static int __gui_render_cached(GUI_Element *elem) {
+	SDL_Renderer *renderer = GUI_Renderer;
+	if (!renderer || !SDL_RenderTargetSupported(renderer)) return 0;
+
+	__gui_update_state(elem);
+	SDL_Rect bounds = __gui_get_bounds(elem);
+	if (bounds.w <= 0 || bounds.h <= 0) return 1; 	// hidden, nothing to draw
 
-			// shift remaining elements back in the list
-			for (int j = i; j < element_count - 1; ++j)
-				elements[j] = elements[j + 1];
+	int w = 0, h = 0;
+	if (elem->cache) SDL_QueryTexture(elem->cache, NULL, NULL, &w, &h);
 
-			element_count--;
-			break;
+	if (!elem->cache || w != bounds.w || h != bounds.h) {
+		if (elem->cache) __gui_destroy_texture(elem->cache);
+		elem->cache = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, bounds.w, bounds.h);
+		if (!elem->cache) return 0;
+		__gui_count_texture(elem->cache, 1);
+
+		// the texture ends up premultiplied (drawn onto transparent black), composite it as such
+		SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+			SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+			SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+		if (SDL_SetTextureBlendMode(elem->cache, premultiplied) != 0) {
+			__gui_destroy_texture(elem->cache); 	// renderer without custom blend modes
+			elem->cache = NULL;
+			elem->cache_mode = DISABLED;
+			return 0;
+		}
+		elem->cache_version = elem->version - 1; 	// contents are undefined
+	}
+
+	if (elem->cache_version != elem->version || elem->cache_theme != current_theme) {
+		SDL_Texture *previous_target = SDL_GetRenderTarget(renderer);
+		SDL_bool clipped = SDL_RenderIsClipEnabled(renderer);
+		SDL_Rect clip;
+		SDL_RenderGetClipRect(renderer, &clip);
+		const SDL_Rect *outer_damage = damage_clip;
+
+		__gui_batch_flush(); 	// queued quads belong to the outer target
+		SDL_SetRenderTarget(renderer, elem->cache);
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+		SDL_RenderClear(renderer);
+
+		// shift the origin so the element draws at its usual coordinates
+		SDL_Rect viewport = { -bounds.x, -bounds.y, bounds.x + bounds.w, bounds.y + bounds.h };
+		SDL_RenderSetViewport(renderer, &viewport);
+		damage_clip = NULL;
+		elem->render(elem->element);
+		damage_clip = outer_damage;
+
+		__gui_batch_flush();
+		SDL_SetRenderTarget(renderer, previous_target);
+		SDL_RenderSetClipRect(renderer, clipped ? &clip : NULL);
+
+		elem->cache_version = elem->version;
+		elem->cache_theme = current_theme;
+	}
+
+	__gui_render_copy(elem->cache, NULL, &bounds, (SDL_Color){ 255, 255, 255, 255 });
+	return 1;
+}
+
+/* Culling */
+
+// opaque overlays of this frame (expanded listboxes), elements drawn before one are hidden beneath it
+static void __gui_collect_occluders() {
+	occluder_count = 0;
+	for (int i = 0; i < element_count && occluder_count < MAX_OCCLUDERS; i++) {
+		GUI_Element *elem = &elements[i];
+		if (elem->element && elem->type == GUI_LISTBOX &&
+			__gui_listbox_opaque_rect(elem->element, &occluders[occluder_count]))
+			occluder_element[occluder_count++] = i;
+	}
+}
+
+// part of the render target elements can show up in: the viewport, narrowed by the clip rect
+static SDL_Rect __gui_visible_area() {
+	SDL_Rect area = {0}, clip;
+	SDL_RenderGetViewport(GUI_Renderer, &area);
+	area.x = area.y = 0; 	// element coordinates are relative to the viewport
+
+	if (SDL_RenderIsClipEnabled(GUI_Renderer)) {
+		SDL_RenderGetClipRect(GUI_Renderer, &clip);
+		if (!SDL_IntersectRect(&area, &clip, &area)) area.w = area.h = 0;
+	}
+	return area;
+}
+
+// can anything of an element be seen within 'area'? (counted for GUI_GetRenderStats())
+static int __gui_is_visible(int index, const SDL_Rect *area) {
+	SDL_Rect bounds = __gui_refresh_bounds(index), shown, covered;
+	if (!SDL_IntersectRect(&bounds, area, &shown)) { 	// hidden, off-screen or clipped away
+		__gui_count_element(0, 0);
+		return 0;
+	}
+
+	// whatever is left of it gets painted over by an overlay drawn later
+	for (int o = 0; o < occluder_count; o++) {
+		if (occluder_element[o] > index && SDL_IntersectRect(&shown, &occluders[o], &covered) &&
+			SDL_RectEquals(&covered, &shown)) {
+			__gui_count_element(0, 1);
+			return 0;
 		}
 	}
+	__gui_count_element(1, 0);
+	return 1;
+}
+
+/* Pointer routing */
+
+static int __gui_push_index(int **array, int *count, int *cap, int value) {
+	if (*count == *cap) {
+		int new_cap = *cap ? *cap * 2 : 16;
+		int *grown = __gui_realloc(*array, sizeof(int) * new_cap, GUI_MEM_ELEMENTS);
+		if (!grown) return 0;
+		*array = grown;
+		*cap = new_cap;
+	}
+	(*array)[(*count)++] = value;
+	return 1;
+}
+
+static int __gui_compare_indices(const void *a, const void *b) {
+	return *(const int *)a - *(const int *)b;
+}
+
+// elements that need pointer events away from their bounds: to release a press or drag, or to react to a click outside
+static int __gui_holds_pointer(GUI_Element *elem) {
+	if (!elem->process) return 0;
+
+	switch (elem->type) {
+	case GUI_BUTTON: return ((GUI_Button *)elem->element)->pressed;
+	case GUI_SLIDER: return ((GUI_Slider *)elem->element)->dragging;
+	case GUI_INPUT: return ((GUI_Input *)elem->element)->focus;
+	case GUI_LISTBOX: return ((GUI_ListBox *)elem->element)->expanded;
+	default: return 0;
+	}
+}
+
+static void __gui_add_receiver(int slot) {
+	for (int i = 0; i < receiver_count; i++)
+		if (receivers[i] == slot) return;
+	__gui_push_index(&receivers, &receiver_count, &receiver_cap, slot);
+}
+
+// deliver a pointer event to the elements under the cursor and the receivers of the previous one
+static void __gui_route_pointer(SDL_Event *event, int mx, int my) {
+	const int *hits;
+	int hit_count = __gui_spatial_query(mx, my, &hits);
+
+	target_count = 0;
+	for (int i = 0; i < hit_count + receiver_count; i++) {
+		int slot = i < hit_count ? hits[i] : receivers[i - hit_count];
+		int index = slots[slot].index; 	// -1: deleted since
+		if (index >= 0) __gui_push_index(&pointer_targets, &target_count, &target_cap, index);
+	}
+	// in drawing order, as when every element got every event
+	qsort(pointer_targets, target_count, sizeof(int), __gui_compare_indices);
+
+	receiver_count = 0;
+	for (int i = 0; i < target_count; i++) {
+		if (i > 0 && pointer_targets[i] == pointer_targets[i - 1]) continue; 	// hovered and receiver
+
+		// callbacks may create elements (the store moves) or delete them
+		GUI_Element *elem = &elements[pointer_targets[i]];
+		if (!elem->element || !elem->process) continue;
+		elem->process(event, elem->element, mx, my);
+
+		// still under the cursor or holding capture: it gets the next pointer event too
+		elem = &elements[pointer_targets[i]];
+		if (elem->element && (__gui_spatial_contains(elem->slot, mx, my) || __gui_holds_pointer(elem)))
+			__gui_add_receiver(elem->slot);
+	}
+}
+
+static void __gui_render_element(GUI_Element *elem) {
+	if (__gui_cache_wanted(elem) && __gui_render_cached(elem)) return;
+
+	if (elem->cache) { 	// no longer cached, e.g. an expanded listbox
+		__gui_destroy_texture(elem->cache);
+		elem->cache = NULL;
+	}
+	elem->render(elem->element);
+}
+
+// repaint the damaged regions of the persistent target and copy it to the window; returns 0 if unsupported
+static int __gui_render_retained() {
+	SDL_Renderer *renderer = GUI_Renderer;
+	int w, h;
+	if (!renderer || !SDL_RenderTargetSupported(renderer) || SDL_GetRendererOutputSize(renderer, &w, &h) != 0)
+		return 0;
+
+	// (re)create the target when the window size changes, its contents start out undefined
+	if (!retained_target || w != target_width || h != target_height) {
+		if (retained_target) __gui_destroy_texture(retained_target);
+		retained_target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+		if (!retained_target) return 0;
+		__gui_count_texture(retained_target, 1);
+
+		SDL_SetTextureBlendMode(retained_target, SDL_BLENDMODE_NONE);
+		target_width = w;
+		target_height = h;
+		__gui_damage_all();
+	}
+	__gui_collect_damage();
+
+	SDL_Texture *previous_target = SDL_GetRenderTarget(renderer);
+	__gui_batch_flush();
+	SDL_SetRenderTarget(renderer, retained_target);
+
+	for (int d = 0; d < damage_count; d++) {
+		__gui_batch_flush(); 	// the previous region's quads use the previous clip
+		damage_clip = &damage[d];
+		SDL_RenderSetClipRect(renderer, damage_clip);
+
+		// clear the region, then draw everything that shows up in it in the usual order
+		__gui_set_color(background_color.r, background_color.g, background_color.b, background_color.a);
+		__gui_fill_rect(damage_clip);
+
+		SDL_Rect area = __gui_visible_area();
+		for (int i = 0; i < element_count; i++) {
+			GUI_Element *elem = &elements[i];
+			if (elem->element && elem->render && __gui_is_visible(i, &area))
+				__gui_render_element(elem);
+		}
+	}
+	__gui_batch_flush();
+	damage_clip = NULL;
+	SDL_RenderSetClipRect(renderer, NULL);
+
+	for (int i = 0; i < element_count; i++)
+		elements[i].animating = elements[i].element && __gui_is_animating(&elements[i]);
+	damage_count = 0;
+
+	SDL_SetRenderTarget(renderer, previous_target);
+	__gui_render_copy(retained_target, NULL, NULL, (SDL_Color){ 255, 255, 255, 255 });
+	return 1;
+}
+
+// in retained mode, GUI_RenderElements() repaints only what changed and copies the result to the window
+// (every element is drawn, tags only filter in immediate mode)
+void GUI_SetRetainedMode(int enable) {
+	retained_mode = enable;
+	__gui_damage_all();
+}
+
+// color of the window behind the elements in retained mode
+void GUI_SetBackgroundColor(SDL_Color color) {
+	if (memcmp(&color, &background_color, sizeof(SDL_Color)) == 0) return;
+
+	background_color = color;
+	__gui_damage_all();
+}
+
+// does anything need to be repainted? (false while idle, so the frame can be skipped)
+int GUI_IsDirty() {
+	GUI_UpdateTimers(); 	// timers and tweens change elements too
+	__gui_collect_damage();
+	return damage_count > 0;
+}
+
+// screen area an element covers (borders, knobs and expanded lists included); returns 0 if it isn't registered
+int GUI_GetElementBounds(void *elem, SDL_Rect *bounds) {
+	GUI_Element *e = __gui_find_element(elem);
+	if (!e || !bounds) return 0;
+
+	*bounds = __gui_refresh_bounds((int)(e - elements));
+	return 1;
+}
+
+// topmost element drawn at a point (bounds as of the last frame or GUI_IsDirty()), NULL if there is none
+void *GUI_GetElementAt(int x, int y) {
+	int index = __gui_hit_test(x, y, GUI_HIT_VISIBLE);
+	return index < 0 || index >= element_count ? NULL : elements[index].element;
+}
+
+// force a region to be repainted, e.g. after drawing over it
+void GUI_Invalidate(const SDL_Rect *rect) {
+	if (rect) __gui_add_damage(rect);
+	else __gui_damage_all();
+}
+
+// state changes the library can't see (e.g. list entry strings edited in place)
+void GUI_InvalidateElement(void *elem) {
+	GUI_Element *e = __gui_find_element(elem);
+	if (!e) return;
+
+	e->version++;
+	__gui_add_damage(&e->bounds);
+}
+
+// draw an element from a texture of its own, redrawn only when its state changes
+// (ENABLED, DISABLED, or -1 to follow GUI_SetAutoCaching)
+void GUI_SetElementCaching(void *elem, int enable) {
+	GUI_Element *e = __gui_find_element(elem);
+	if (!e) return;
+
+	e->cache_mode = enable;
+	if (enable == DISABLED && e->cache) {
+		__gui_destroy_texture(e->cache);
+		e->cache = NULL;
+	}
+}
+
+// cache labels, buttons, checkboxes, radio buttons and collapsed listboxes automatically
+void GUI_SetAutoCaching(int enable) {
+	auto_caching = enable;
 }
 
 void GUI_RenderElements(const char *tag) {
+	GUI_UpdateTimers();
+	__gui_text_cache_upload(); 	// strings rasterized by the text workers since the last frame
+	__gui_batch_begin(); 			// submit the frame in as few draw calls as possible
+	if (element_gaps > element_count / 2) __gui_compact_elements(); 	// no loop over the elements is running here
+	__gui_frame_reset(); 		// scratch memory of the previous frame
+	__gui_collect_occluders();
+
+	if (retained_mode && __gui_render_retained()) {
+		__gui_batch_end();
+		return;
+	}
+
+	SDL_Rect area = __gui_visible_area();
 	for (int i = 0; i < element_count; i++) {
 		GUI_Element *elem = &elements[i];
 		// missing element or an element with no render function (e.g. groups)
-		if (!elem || elem->render == NULL) continue;
+		if (!elem->element || elem->render == NULL) continue;
 
 		// check if tag is NULL or empty
 		if (tag && tag[0] != '\0') {
 			const char *elem_tag = ((GUI_ElementTag*)elem->element)->tag;
 			if (!elem_tag || strcmp(elem_tag, tag) != 0) continue; // ignore element if tags don't match
 		}
-		// get current element's render function and pass the element to it
-		elem->render(elem->element);
+		// nothing of it would end up on screen
+		if (!__gui_is_visible(i, &area)) continue;
+
+		// get current element's render function and pass the element to it (or draw its cached texture)
+		__gui_render_element(elem);
+	}
+	__gui_batch_end();
+
+	// everything has been drawn, nothing is left damaged
+	damage_count = 0;
+	for (int i = 0; i < element_count; i++) {
+		elements[i].animating = elements[i].element && __gui_is_animating(&elements[i]);
+
+		// capture can be taken outside of event processing too (e.g. a list expanded by the program)
+		if (elements[i].element && __gui_holds_pointer(&elements[i])) __gui_add_receiver(elements[i].slot);
+	}
+}
+
+// milliseconds until an element changes by itself (-1: none will, the loop can sleep until the next event)
+// timers and tweens are covered by the scheduler, this catches elements animated while being drawn
+int __gui_next_deadline(Uint32 frame_interval) {
+	for (int i = 0; i < element_count; i++) {
+		GUI_Element *elem = &elements[i];
+		if (!elem->element) continue;
+
+		if (elem->animating || __gui_is_animating(elem))
+			return (int)frame_interval; 	// animations advance once per frame
 	}
+	return -1;
 }
 
+// clear the window before an immediate mode frame (retained mode clears damaged regions itself)
+void __gui_clear_frame() {
+	if (retained_mode) return;
+
+	__gui_batch_flush();
+	SDL_SetRenderDrawColor(GUI_Renderer, background_color.r, background_color.g, background_color.b, background_color.a);
+	SDL_RenderClear(GUI_Renderer);
+}
+
+// pass an event on: pointer events to the elements under the cursor and those holding capture, others to all
 void GUI_ProcessEvents(SDL_Event *event) {
 	int mx, my;
 	SDL_GetMouseState(&mx, &my);
 
+	// window contents were lost or resized
+	if (event->type == SDL_WINDOWEVENT &&
+		(event->window.event == SDL_WINDOWEVENT_EXPOSED || event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED))
+		__gui_damage_all();
+
+	if (event->type == SDL_MOUSEMOTION || event->type == SDL_MOUSEBUTTONDOWN ||
+		event->type == SDL_MOUSEBUTTONUP || event->type == SDL_MOUSEWHEEL) {
+		__gui_route_pointer(event, mx, my);
+		return;
+	}
+
 	for (int i = 0; i < element_count; i++) {
 		GUI_Element *elem = &elements[i];
 		if (!elem->element || !elem->process) continue; // missing element, missing process function
@@ -178,22 +1025,91 @@ void GUI_ProcessEvents(SDL_Event *event) {
 
 // add newly created element to a universal list
 void __gui_add_element(GUI_ElementType type, void *elem, GUI_Render render, GUI_Process process) {
-	if (element_count >= MAX_ELEMENTS) return;
+	if (!elem) return;
+
+	// grow in place, elements may be created while the list is being looped over (e.g. on a click)
+	if (element_count == element_cap) {
+		int cap = element_cap ? element_cap * 2 : MIN_ELEMENT_CAP;
+		GUI_Element *grown = __gui_realloc(elements, sizeof(GUI_Element) * cap, GUI_MEM_ELEMENTS);
+		if (!grown) {
+			printf("\n[!] Failed to grow the element list to %d elements.\n", cap);
+			return;
+		}
+		elements = grown;
+		element_cap = cap;
+	}
+
+	// reuse a slot of a deleted element or take a new one
+	int slot = free_slot;
+	if (slot >= 0) {
+		free_slot = slots[slot].next_free;
+	} else {
+		if (slot_count == slot_cap) {
+			int cap = slot_cap ? slot_cap * 2 : MIN_ELEMENT_CAP;
+			GUI_ElementSlot *grown = __gui_realloc(slots, sizeof(GUI_ElementSlot) * cap, GUI_MEM_ELEMENTS);
+			if (!grown) {
+				printf("\n[!] Failed to grow the element slots to %d.\n", cap);
+				return;
+			}
+			slots = grown;
+			slot_cap = cap;
+		}
+		slot = slot_count++;
+		slots[slot].generation = 1;
+	}
+	if (!__gui_lookup_insert(elem, slot)) {
+		slots[slot].index = -1;
+		slots[slot].next_free = free_slot; 	// give the slot back
+		free_slot = slot;
+		return;
+	}
+	slots[slot].index = element_count;
 
 	GUI_Element e = {
 		.type = type,
 		.element = elem,
 		.render = render,
-		.process = process
+		.process = process,
+		.bounds = {0},
+		.state = 0, 	// differs from any real state, so the element is damaged on the next frame
+		.version = 0,
+		.animating = 0,
+		.cache = NULL,
+		.cache_version = 0,
+		.cache_theme = NULL,
+		.cache_mode = -1,
+		.slot = slot,
+		.screen = __gui_current_screen()
 	};
 	elements[element_count++] = e;
+	__gui_refresh_bounds(element_count - 1);
+}
+
+// mark a region for repainting, overlapping regions are merged
+void __gui_add_damage(const SDL_Rect *rect) {
+	if (!rect || rect->w <= 0 || rect->h <= 0) return;
+
+	SDL_Rect r = *rect;
+	for (int i = 0; i < damage_count; i++) {
+		if (SDL_HasIntersection(&r, &damage[i])) {
+			SDL_UnionRect(&r, &damage[i], &r);
+			damage[i] = damage[--damage_count];
+			i = -1; 	// the grown region may overlap ones already checked
+		}
+	}
+
+	// too many separate regions, repaint their bounding box instead
+	if (damage_count == MAX_DAMAGE_RECTS) {
+		for (int i = 0; i < damage_count; i++)
+			SDL_UnionRect(&r, &damage[i], &r);
+		damage_count = 0;
+	}
+	damage[damage_count++] = r;
 }
 
 void __gui_draw_borders(int x, int y, int width, int height, int border_width) {
 	if (border_width < 1) return; 	// no borders
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
 	// get element's location and offset it
 	SDL_Rect border_rect = {
 		x - border_width, 			// top and left borders
@@ -201,45 +1117,31 @@ void __gui_draw_borders(int x, int y, int width, int height, int border_width) {
 		width + border_width * 2, 	// bottom and right borders
 		height + border_width * 2
 	};
-	SDL_SetRenderDrawColor(renderer, SET_COLOR_BORDER);
-	SDL_RenderFillRect(renderer, &border_rect);
+	// only the four edges, the element fills its body itself
+	SDL_Rect body_rect = { x, y, width, height };
+	__gui_set_color(SET_COLOR_BORDER);
+	__gui_fill_rect_around(&border_rect, &body_rect);
 }
 
-// helper function to render regular text
+// helper function to render regular text, long texts are cut short with an ellipsis to fit the target rect
 void __gui_render_text(const char *text, SDL_Rect *target_rect, SDL_Color color) {
-	SDL_Renderer *renderer = GUI_GetRenderer();
 	if (!text || !*text || !target_rect) return;
 
-	SDL_Surface *surface = TTF_RenderUTF8_Blended(default_font, text, color);
-	SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+	GUI_Font *font = GUI_GetFont();
+	if (!font) return;
 
-	int text_w, text_h;
-	SDL_QueryTexture(texture, NULL, NULL, &text_w, &text_h);
+	GUI_TextFit fit = __gui_text_fit(font, text, target_rect->w);
 
-	SDL_Rect text_rect = {
-		target_rect->x,
-		target_rect->y + (target_rect->h - text_h) / 2,
-		text_w,
-		text_h
-	};
-	SDL_RenderCopy(renderer, texture, NULL, &text_rect);
-
-	SDL_FreeSurface(surface);
-	SDL_DestroyTexture(texture);
+	// center vertically within the target rect
+	__gui_text_draw_fit(font, text, &fit, target_rect->x, target_rect->y + (target_rect->h - font->height) / 2, color);
 }
 
 // helper function to render clipped text (cut off long texts)
 void __gui_render_text_clipped(const char *text, SDL_Rect *input_rect, int text_offset, SDL_Color color) {
 	if (!text || !*text || !input_rect) return;
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
-	SDL_Surface *surface = TTF_RenderUTF8_Blended(default_font, text, color);
-	SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-
-	// store text proportions
-	int text_width, text_height;
-	TTF_SizeUTF8(default_font, text, &text_width, &text_height);
+	GUI_Font *font = GUI_GetFont();
+	if (!font) return;
 
 	// clip area to prevent text from overflowing
 	SDL_Rect clip_rect = {
@@ -248,26 +1150,22 @@ void __gui_render_text_clipped(const char *text, SDL_Rect *input_rect, int text_
 		input_rect->w - 8,
 		input_rect->h - 4
 	};
-	SDL_RenderSetClipRect(renderer, &clip_rect);
+	// nothing to draw outside of the region being repainted in retained mode
+	if (damage_clip && !SDL_HasIntersection(&clip_rect, damage_clip)) return;
+	__gui_push_clip(&clip_rect);
 
 	// visible part of text
-	SDL_Rect text_rect = {
-		input_rect->x + 4 - text_offset,
-		input_rect->y + (input_rect->h - text_height) / 2,
-		text_width,
-		text_height
-	};
-	SDL_Rect *src_rect = NULL;
-
-	SDL_RenderCopy(renderer, texture, src_rect, &text_rect);
-	SDL_RenderSetClipRect(renderer, NULL); 	// reset back to default
+	__gui_text_draw(font, text, -1, input_rect->x + 4 - text_offset, input_rect->y + (input_rect->h - font->height) / 2, color);
 
-	SDL_DestroyTexture(texture);
-	SDL_FreeSurface(surface);
+	__gui_pop_clip(); 	// reset back to default
 }
 
-// helper function for SDL2_gfx geometric functions
-// uses bit-shifting to obtain specific byte
-Uint32 __gui_color_to_uint32(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-    return (a << 24) | (r << 16) | (g << 8) | b;
-}
\ No newline at end of file
+// FNV-1a hash, continues from 'hash' (start with GUI_HASH_INIT)
+Uint32 __gui_hash_bytes(Uint32 hash, const void *data, size_t len) {
+	const Uint8 *bytes = (const Uint8 *)data;
+	for (size_t i = 0; i < len; i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
@@ -34,7 +34,31 @@ extern SDL_Window *GUI_GetWindow();
 EXPORT int GUI_Init(SDL_Window *window, SDL_Renderer *renderer);
 EXPORT void GUI_Quit();
 
-extern TTF_Font *default_font; // TODO: implement GUI_GetFont()
+/* Fonts (shared between elements, keyed by file and point size) */
+
+typedef struct GUI_Font {
+	char *path;
+	int size,
+		refs, 						// number of users, the font is closed when it drops to 0
+		height, 					// line height in pixels
+		sdf; 						// glyphs are signed distance fields
+	float scale; 					// size relative to the base font (SDF sizes only)
+	TTF_Font *ttf; 					// NULL for SDF sizes, they draw from their base font
+	SDL_mutex *lock; 				// held around SDL_ttf calls, strings are rasterized on worker threads
+	struct GUI_Font *base; 			// SDF sizes: shared typeface the glyphs come from
+	struct GUI_GlyphAtlas *atlas; 	// glyph atlas (text.c), created on first use
+	struct GUI_Font *next;
+} GUI_Font;
+
+EXPORT GUI_Font *GUI_OpenFont(const char *path, int size);
+EXPORT void GUI_CloseFont(GUI_Font *font);
+EXPORT GUI_Font *GUI_GetFont(); 	// borrowed, must not be closed
+EXPORT void GUI_SetSDFText(int enable); 	// atlas-drawn text ignores label styles
+EXPORT int GUI_AddBakedFont(const char *baked_path, const char *font_path); 	// so does baked text
+int __gui_font_init();
+void __gui_font_quit();
+void __gui_font_lock(GUI_Font *font);
+void __gui_font_unlock(GUI_Font *font);
 
 // for in-library use only (not available to end user)
 // internal functions are all lowercase and start with a double underscore
@@ -42,7 +66,183 @@ extern TTF_Font *default_font; // TODO: implement GUI_GetFont()
 void __gui_draw_borders(int x, int y, int width, int height, int border_width);
 void __gui_render_text(const char *text, SDL_Rect *target_rect, SDL_Color color);
 void __gui_render_text_clipped(const char *text, SDL_Rect *input_rect, int text_offset, SDL_Color color);
-Uint32 __gui_color_to_uint32(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+
+#define GUI_HASH_INIT 	2166136261u
+Uint32 __gui_hash_bytes(Uint32 hash, const void *data, size_t len);
+
+/* Anti-aliased primitives (tessellated, cached meshes) */
+
+typedef struct {
+	SDL_Vertex *vertices; 	// relative to the origin, white with the coverage in alpha
+	int *indices;
+	int vertex_count, index_count;
+	SDL_Rect bounds; 		// relative to the origin
+} GUI_Mesh;
+
+void __gui_draw_line(int x1, int y1, int x2, int y2);
+void __gui_fill_circle(float cx, float cy, float radius);
+void __gui_draw_circle(float cx, float cy, float radius, float thickness);
+void __gui_fill_rounded_rect(const SDL_Rect *rect, int radius);
+void __gui_draw_rounded_border(const SDL_Rect *rect, int radius, int thickness);
+void __gui_primitives_quit();
+
+/* Widget sprites (alpha masks in a shared atlas, tinted per draw) */
+
+typedef enum {
+	GUI_SPRITE_CHECKMARK, 		// anchored at the checkbox's top-left corner
+	GUI_SPRITE_ARROW_UP, 		// arrows and circles are anchored at their center pixel
+	GUI_SPRITE_ARROW_DOWN,
+	GUI_SPRITE_ARROW_LEFT,
+	GUI_SPRITE_ARROW_RIGHT,
+	GUI_SPRITE_RING, 			// one pixel wide circle of radius 'size'
+	GUI_SPRITE_DISC 			// filled circle of radius 'size'
+} GUI_SpriteType;
+
+void __gui_draw_sprite(GUI_SpriteType type, int size, int x, int y);
+void __gui_sprites_quit();
+
+/* Render command list (recorded per frame, replayed sorted by state) */
+
+typedef enum {
+	GUI_CMD_QUAD, 		// colored (no texture) or textured quad, src holds normalized u0, v0, u1, v1
+	GUI_CMD_MESH, 		// cached mesh tinted with color, origin in rect.x, rect.y
+	GUI_CMD_COPY, 		// texture copy, src in pixels (empty: whole texture)
+	GUI_CMD_PUSH_CLIP, 	// intersect the clip rectangle with rect
+	GUI_CMD_POP_CLIP
+} GUI_CommandType;
+
+typedef struct {
+	GUI_CommandType type;
+	SDL_Texture *texture;
+	const GUI_Mesh *mesh;
+	SDL_FRect rect, src;
+	SDL_Color color;
+} GUI_DrawCommand;
+
+typedef struct {
+	int draw_calls, 	// renderer submissions (geometry batches, lines and texture copies)
+		quads, 			// quads drawn through the command list
+		commands; 		// commands recorded
+	Uint64 pixels; 		// area covered by quads and copies, overdrawn pixels count every time
+	int elements_drawn, 	// render calls (per damaged region in retained mode)
+		elements_culled, 	// skipped: hidden, outside the window or the clip rect
+		elements_occluded; 	// skipped: under an opaque overlay (expanded listbox)
+} GUI_RenderStats;
+
+void __gui_batch_flush();
+void __gui_batch_quad(SDL_Texture *texture, float x, float y, float w, float h, float u0, float v0, float u1, float v1, SDL_Color color);
+void __gui_batch_done();
+void __gui_batch_begin();
+void __gui_batch_end();
+void __gui_batch_quit();
+void __gui_set_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+SDL_Color __gui_get_color();
+void __gui_fill_rect(const SDL_Rect *rect);
+void __gui_fill_rect_around(const SDL_Rect *rect, const SDL_Rect *hole);
+void __gui_batch_mesh(const GUI_Mesh *mesh, float x, float y);
+void __gui_render_copy(SDL_Texture *texture, const SDL_Rect *src, const SDL_Rect *dst, SDL_Color color);
+void __gui_push_clip(const SDL_Rect *rect);
+void __gui_pop_clip();
+void __gui_destroy_texture(SDL_Texture *texture);
+EXPORT void GUI_GetRenderStats(GUI_RenderStats *stats);
+void __gui_count_element(int drawn, int occluded);
+EXPORT void GUI_SetFrameCapture(int enable);
+EXPORT const GUI_DrawCommand *GUI_GetCapturedFrame(int *count);
+EXPORT void GUI_ReplayCapturedFrame();
+
+/* Scheduler (timers and tweens on a hierarchical timer wheel, see scheduler.c) */
+
+typedef Uint32 GUI_TimerID; 	// 0: no timer
+typedef void (*GUI_TimerCallback)(void *args);
+
+typedef enum {
+	GUI_EASE_LINEAR,
+	GUI_EASE_OUT, 		// fast start, slows down towards the target
+	GUI_EASE_IN_OUT
+} GUI_Easing;
+
+EXPORT GUI_TimerID GUI_AddTimer(Uint32 delay_ms, Uint32 interval_ms, GUI_TimerCallback callback, void *args);
+EXPORT GUI_TimerID GUI_AddTween(float *value, float target, Uint32 duration_ms, GUI_Easing easing);
+EXPORT void GUI_CancelTimer(GUI_TimerID id);
+EXPORT void GUI_UpdateTimers();
+int __gui_scheduler_next_deadline(Uint32 frame_interval);
+void __gui_scheduler_quit();
+
+/* Run loop (sleeps until the next event or deadline, renders only when something changed) */
+
+EXPORT int GUI_PumpFrame(int timeout_ms);
+EXPORT void GUI_Run(void (*on_frame)(void *args), void *args);
+EXPORT void GUI_SetFrameCallback(void (*on_frame)(void *args), void *args);
+EXPORT void GUI_RequestFrame(Uint32 delay_ms);
+EXPORT void GUI_SetVSync(int enable);
+EXPORT void GUI_StopRunning();
+int __gui_next_deadline(Uint32 frame_interval);
+void __gui_clear_frame();
+
+/* Baked fonts (written by fontbake.c, memory-mapped by GUI_AddBakedFont) */
+
+#define GUI_BAKED_MAGIC 		0x46425547 	// "GUBF"
+#define GUI_BAKED_VERSION 		1
+
+// file layout, all fields little-endian:
+// header, glyphs, kerning pairs, then the atlas with one alpha byte per pixel
+typedef struct {
+	Uint32 magic, version,
+		size, height, 				// point size and line height in pixels
+		atlas_width, atlas_height,
+		glyph_count, kerning_count;
+} GUI_BakedHeader;
+
+typedef struct {
+	Uint32 ch; 						// unicode code point
+	Sint16 advance, offset_x;
+	Uint16 x, y, w, h; 				// glyph image in the atlas
+} GUI_BakedGlyph;
+
+typedef struct {
+	Uint32 left, right; 			// code points of the pair
+	Sint32 kerning;
+} GUI_BakedKerning;
+
+/* Text engine (glyph atlas per font) */
+
+Uint32 __gui_utf8_decode(const char **text, const char *end);
+void __gui_text_size(GUI_Font *font, const char *text, int len, int *width, int *height);
+int __gui_text_advance(GUI_Font *font, Uint32 prev, Uint32 ch);
+void __gui_text_draw(GUI_Font *font, const char *text, int len, int x, int y, SDL_Color color);
+void __gui_text_release_font(GUI_Font *font);
+int __gui_text_load_baked(GUI_Font *font, const Uint8 *data, size_t size);
+
+// string fitted into a width; long strings are cut short and end with an ellipsis
+typedef struct {
+	int length, 			// bytes of the original string that are drawn
+		width, 				// width of the fitted text, ellipsis included
+		ellipsis_x; 		// x offset of the ellipsis
+	const char *ellipsis; 	// NULL if the whole string fits
+} GUI_TextFit;
+
+GUI_TextFit __gui_text_fit(GUI_Font *font, const char *text, int max_width);
+void __gui_text_draw_fit(GUI_Font *font, const char *text, const GUI_TextFit *fit, int x, int y, SDL_Color color);
+
+/* Text cache (rendered strings, LRU eviction under a texture memory budget) */
+
+typedef struct {
+	Uint64 hits, misses, evictions;
+	size_t bytes, 		// texture memory currently held by the cache
+		   budget; 		// max texture memory before least recently used entries are evicted
+	int entries;
+} GUI_TextCacheStats;
+
+struct GUI_TextCacheEntry *__gui_text_cache_acquire(GUI_Font *font, const char *text, int len, int style);
+void __gui_text_cache_release(struct GUI_TextCacheEntry *entry);
+SDL_Texture *__gui_text_cache_texture(struct GUI_TextCacheEntry *entry, int *width, int *height);
+void __gui_text_cache_release_font(GUI_Font *font);
+void __gui_text_cache_upload();
+void __gui_text_cache_quit();
+EXPORT void GUI_SetTextWorkers(int count);
+EXPORT void GUI_SetTextCacheBudget(size_t bytes);
+EXPORT void GUI_GetTextCacheStats(GUI_TextCacheStats *stats);
+EXPORT void GUI_ClearTextCache();
 
 /* Theme color palette template */
 
@@ -81,7 +281,8 @@ typedef enum {
 	GUI_RADIOBUTTON,
 	GUI_RADIOGROUP,
 	GUI_PROGRESSBAR,
-	GUI_LISTBOX
+	GUI_LISTBOX,
+	GUI_ELEMENT_TYPE_COUNT
 } GUI_ElementType;
 
 // Generic container for storing pointers to any type of element
@@ -97,21 +298,150 @@ typedef struct {
 	GUI_Render render;
 	GUI_Process process;
 	// void (*destroy)(void*);  // TODO: simplify GUI_Quit()
+
+	// retained rendering: what the element looked like when it was last drawn
+	SDL_Rect bounds; 	// screen area covered, including borders
+	Uint32 state, 		// hash of the fields that affect its appearance
+		version; 		// bumped whenever the state changes
+	int animating; 		// its render function changes it over time (needs more frames)
+
+	// render-to-texture cache of the element's visual
+	SDL_Texture *cache;
+	Uint32 cache_version; 			// version the cache was drawn at
+	const GUI_Theme *cache_theme; 	// theme the cache was drawn with
+	int cache_mode; 				// -1: follow GUI_SetAutoCaching(), otherwise ENABLED or DISABLED
+
+	int slot, 			// entry in the slot table that points back here (handles go through it)
+		screen; 		// screen the element was created on (owns its memory, see GUI_PushScreen())
 } GUI_Element;
 
+// refers to an element without keeping a pointer that may dangle: deleting the element invalidates it
+typedef Uint64 GUI_Handle; 	// slot and generation, 0: none
+
 void __gui_add_element(GUI_ElementType type, 	// index from GUI_ElementType enum
 						void *elem, 			// pointer to data type (e.g. GUI_Button)
 						GUI_Render render, 		// pointer to element's render function
 						GUI_Process process); 	// pointer to element's processing function
 EXPORT void GUI_DeleteElement(void *elem);
+EXPORT GUI_Handle GUI_GetHandle(void *elem);
+EXPORT void *GUI_GetElement(GUI_Handle handle); 	// NULL once the element was deleted
+EXPORT int GUI_GetElementBounds(void *elem, SDL_Rect *bounds); 	// screen area it covers, used for culling
+EXPORT void *GUI_GetElementAt(int x, int y); 	// topmost element drawn at a point, NULL: none
 EXPORT void GUI_RenderElements();
-EXPORT void GUI_ProcessEvents(SDL_Event *event);
+EXPORT void GUI_ProcessEvents(SDL_Event *event); 	// pointer events go to the elements under the cursor and those holding capture
+
+// screens: elements created after a push are deleted together, and their memory freed at once, by the matching pop
+EXPORT int GUI_PushScreen();
+EXPORT void GUI_PopScreen();
+
+// retained mode: only damaged regions are repainted into a persistent target
+EXPORT void GUI_SetRetainedMode(int enable);
+EXPORT void GUI_SetBackgroundColor(SDL_Color color);
+EXPORT int GUI_IsDirty();
+EXPORT void GUI_Invalidate(const SDL_Rect *rect); 	// NULL: whole window
+EXPORT void GUI_InvalidateElement(void *elem);
+
+// cache static elements in a texture of their own, redrawn only when their state changes
+EXPORT void GUI_SetElementCaching(void *elem, int enable);
+EXPORT void GUI_SetAutoCaching(int enable);
+void __gui_add_damage(const SDL_Rect *rect);
 
 // helper struct for tag-based checks and filters
 typedef struct {
 	const char *tag;
 } GUI_ElementTag;
 
+/* Memory (allocator hooks, accounting, slab pools per element type owned by screens, frame arena; see pool.c) */
+
+// every allocation of the library goes through these (GUI_SetAllocator), 'userdata' is passed along
+typedef struct {
+	void *(*malloc)(size_t size, void *userdata);
+	void *(*realloc)(void *ptr, size_t size, void *userdata);
+	void (*free)(void *ptr, void *userdata);
+	void *userdata;
+} GUI_Allocator;
+
+// what the memory is used for
+typedef enum {
+	GUI_MEM_ELEMENTS, 		// element structs, the element store and per-element arrays
+	GUI_MEM_STRINGS, 		// input buffers, copied strings and the rendered string cache
+	GUI_MEM_LIST_ENTRIES, 	// listbox entries
+	GUI_MEM_TEXT, 			// fonts, glyph tables and text layout
+	GUI_MEM_RENDER, 		// command lists, geometry and cached meshes
+	GUI_MEM_SCRATCH, 		// frame arena
+	GUI_MEM_CATEGORY_COUNT
+} GUI_MemoryCategory;
+
+typedef struct {
+	size_t bytes[GUI_MEM_CATEGORY_COUNT], 	// currently allocated
+		peak_bytes[GUI_MEM_CATEGORY_COUNT]; 	// most ever allocated at once
+	int allocations[GUI_MEM_CATEGORY_COUNT]; 	// live blocks
+	size_t total_bytes;
+	Uint64 texture_bytes; 		// pixel memory of the library's textures (estimated from size and format)
+	int textures;
+} GUI_MemoryStats;
+
+EXPORT int GUI_SetAllocator(const GUI_Allocator *allocator); 	// NULL: C library
+EXPORT void GUI_GetMemoryStats(GUI_MemoryStats *stats);
+void *__gui_malloc(size_t size, GUI_MemoryCategory category);
+void *__gui_calloc(size_t count, size_t size, GUI_MemoryCategory category);
+void *__gui_realloc(void *ptr, size_t size, GUI_MemoryCategory category);
+char *__gui_strdup(const char *text, GUI_MemoryCategory category);
+void __gui_free(void *ptr);
+void __gui_count_texture(SDL_Texture *texture, int created);
+
+typedef struct GUI_ArenaBlock {
+	struct GUI_ArenaBlock *next;
+	size_t used, size; 			// bytes handed out and available (the data follows the header)
+} GUI_ArenaBlock;
+
+typedef struct {
+	GUI_ArenaBlock *blocks; 	// newest first, allocations come from the first one
+	size_t block_size; 			// size of new blocks (0: default)
+	GUI_MemoryCategory category; 	// counted as
+} GUI_Arena;
+
+typedef struct {
+	void *slabs, 				// blocks of objects, chained through their first bytes
+		*free_list; 			// unused objects, chained the same way
+	size_t object_size;
+	int live; 					// objects in use
+} GUI_Pool;
+
+void *__gui_arena_alloc(GUI_Arena *arena, size_t size);
+void __gui_arena_reset(GUI_Arena *arena);
+void __gui_arena_free(GUI_Arena *arena);
+void *__gui_alloc_element(GUI_ElementType type);
+void __gui_free_element(GUI_ElementType type, int screen, void *elem);
+void *__gui_frame_alloc(size_t size);
+void __gui_frame_reset();
+int __gui_current_screen();
+int __gui_screen_push();
+void __gui_screen_release();
+void __gui_memory_quit();
+
+/* Hit testing (element bounds as columns, tested several rows per instruction; see hittest.c) */
+
+// what a row of the table can be hit for
+typedef enum {
+	GUI_HIT_VISIBLE = 1, 		// shown, with an area
+	GUI_HIT_ENABLED = 2 		// reacts to input (has a process function and isn't disabled)
+} GUI_HitFlags;
+
+void __gui_hit_set(int index, const SDL_Rect *bounds, Uint32 flags);
+void __gui_hit_move(int from, int to);
+void __gui_hit_truncate(int count);
+int __gui_hit_test(int x, int y, Uint32 flags);
+void __gui_hit_quit();
+
+/* Spatial index (elements by the cells of a hashed uniform grid they overlap, for pointer routing; see spatial.c) */
+
+void __gui_spatial_update(int slot, const SDL_Rect *bounds);
+void __gui_spatial_remove(int slot);
+int __gui_spatial_contains(int slot, int x, int y);
+int __gui_spatial_query(int x, int y, const int **slots);
+void __gui_spatial_quit();
+
 /* Scrollbar */
 
 typedef struct GUI_Scrollbar {
@@ -131,18 +461,36 @@ int __gui_process_scrollbar(GUI_Scrollbar *sb, SDL_Event *event, int mx, int my,
 
 /* Label */
 
+// one line of a label's cached layout
+typedef struct {
+	int start, length, 					// byte span within the label text
+		width, height;
+	struct GUI_TextCacheEntry *texture; // rendered line, kept in the text cache for as long as the layout lives
+} GUI_LabelLine;
+
 typedef struct {
 	const char *tag;  // used to filter or group elements together
 	int x, y, visible;
 	char *text;
 	SDL_Color color;
-	TTF_Font *font;
+	GUI_Font *font; 	// shared font handle (GUI_OpenFont)
+	int style; 			// TTF_STYLE_* flags (bold, italic, underline, strikethrough)
+
+	// cached layout, rebuilt only when the text content, font or style changes (color is applied when drawing)
+	Uint32 layout_hash; 		// content hash of the text the layout was built from
+	GUI_Font *layout_font;
+	int layout_style,
+		line_count, line_cap,
+		width, height; 			// size of the whole text block
+	GUI_LabelLine *lines;
 } GUI_Label;
 
 EXPORT GUI_Label *GUI_CreateLabel(int x, int y, char *text);
 EXPORT GUI_Label *GUI_CreateLabelEx(int x, int y, char *text, const char *font_path, int text_size);
 EXPORT void GUI_RenderLabel(GUI_Label *label);
 EXPORT void GUI_DestroyLabel(GUI_Label *label);
+EXPORT void GUI_SetLabelTextSize(GUI_Label *label, int size);
+int __gui_label_update_layout(GUI_Label *label);
 
 /* Button */
 
@@ -151,7 +499,8 @@ typedef struct GUI_Button {
     int x, y, width, height, border_width, 	// location and proportions
 		enabled, visible, 					// available for processing and rendering
 		hovered, pressed, 					// change color based on this state (mouse-over, on-click)
-		text_size;
+		text_size,
+		corner_radius; 						// rounded corners (0: square)
     const char *text;
 	void (*on_click)(void*); 	// function to execute when the button is clicked
 	void *args; 				// optional data to pass to on_click()
@@ -194,14 +543,23 @@ typedef struct {
 		max_length, 			// max input length/character limit
 		text_size,
 		caret_visible, 			// toggles caret visibility (blinking vertical cursor)
-		last_blink, 			// stores the last time it blinked for a smoother appearance
 		text_offset; 			// tracks position for text scrolling on overflow
     char *text; 				// stores user input
 	const char *placeholder; 	// faded placeholder text or hint text
+
+	// caret positions between glyphs, rebuilt when the text changes
+	int *glyph_x, 				// prefix sums of glyph advances: x offset of each caret position
+		*glyph_byte, 			// byte index of each caret position within the text
+		glyph_count, 			// number of caret positions (glyphs + 1)
+		glyph_cap,
+		layout_dirty;
+	Uint32 layout_hash; 		// content hash of the text the caret positions were measured from
+	GUI_TimerID blink_timer; 	// toggles caret_visible while in focus
 } GUI_Input;
 
 EXPORT GUI_Input *GUI_CreateInputField(int x, int y, int width, int max_len, char *placeholder);
 EXPORT void GUI_RenderInput(GUI_Input *input);
+void __gui_input_update_caret(GUI_Input *input);
 
 /* Checkbox */
 
@@ -234,7 +592,8 @@ typedef struct {
 
 typedef struct GUI_RadioGroup {
 	GUI_RadioButton **buttons; 	// array of pointers to individual radio buttons
-	int button_count;
+	int button_count,
+		button_cap; 			// allocated size of 'buttons'
 } GUI_RadioGroup;
 
 EXPORT GUI_RadioButton *GUI_CreateRadioButton(int x, int y);
@@ -252,10 +611,14 @@ typedef struct {
 		min, max,
 		value; 	// actual value
 	float pos; 	// in-between value to smoothe large jumps in progress
+	int target; 		// value 'pos' is being eased towards
+	GUI_TimerID tween;
 } GUI_ProgressBar;
 
 EXPORT GUI_ProgressBar *GUI_CreateProgressBar(int x, int y, int width, int min, int max);
 EXPORT void GUI_RenderProgressBar(GUI_ProgressBar *bar);
+int __gui_progress_fill(GUI_ProgressBar *bar, float pos);
+void __gui_progress_update(GUI_ProgressBar *bar);
 
 /* List box */
 
@@ -272,6 +635,7 @@ typedef struct {
 		entry_height, 			// height of one entry field
 		visible,
 		entry_count, 			// total number of entries
+		entry_cap, 				// allocated size of 'entries'
 		selected_id,
 		max_visible, 			// how many entries are visible at once
 		show_scrollbar, 		// if entry_count > max_visible, render a scrollbar
@@ -290,6 +654,7 @@ EXPORT void GUI_AddListEntry(GUI_ListBox *lb, const char *entry);
 EXPORT void GUI_SetListEntries(GUI_ListBox *lb, const char **texts, int count);
 EXPORT void GUI_SelectListEntry(GUI_ListBox *lb, int index);
 EXPORT void GUI_RenderListBox(GUI_ListBox *listbox);
+int __gui_listbox_opaque_rect(GUI_ListBox *listbox, SDL_Rect *rect);
 
 
 #ifdef __cplusplus
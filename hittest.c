@@ -0,0 +1,158 @@
+/*
+	Hit testing. Next to its elements the element store keeps their
+	bounds as a table of columns (left, top, right, bottom, flags),
+	row i belonging to elements[i]. Finding the element under a point
+	is one pass over the columns from the top of the drawing order
+	down, testing 8 (AVX2) or 4 (SSE2, NEON) rectangles per compare;
+	compilers with neither (e.g. TCC) get a plain loop over the rows.
+
+	Rows are refreshed wherever the library computes an element's
+	bounds (creation, damage collection, culling), so they are as
+	current as the last frame. Rows of gaps and rows past the last
+	element have no flags and never match.
+*/
+
+#include <stdio.h>  // printf
+#include <SDL2/SDL.h>
+#include "guilib.h"
+#include "defs.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HIT_LANES 			8
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+#define HIT_LANES 			4 		// intrinsics come with SDL_cpuinfo.h
+#else
+#define HIT_LANES 			1
+#endif
+#define MIN_HIT_ROWS 		64 		// initial size of the table, doubled when full (a multiple of every lane count)
+
+typedef enum { HIT_LEFT, HIT_TOP, HIT_RIGHT, HIT_BOTTOM, HIT_FLAGS, HIT_COLUMNS } GUI_HitColumn;
+
+static Sint32 *table = NULL; 				// the columns, one after the other
+static Sint32 *columns[HIT_COLUMNS];
+static int row_count = 0, row_cap = 0; 		// rows up to the last one in use, rows allocated
+
+static int __gui_hit_reserve(int count) {
+	if (count <= row_cap) return 1;
+
+	int cap = row_cap ? row_cap : MIN_HIT_ROWS;
+	while (cap < count) cap *= 2;
+
+	// zeroed: rows past the last element are tested too (whole vectors at a time) and must not match
+	Sint32 *grown = __gui_calloc((size_t)cap * HIT_COLUMNS, sizeof(Sint32), GUI_MEM_ELEMENTS);
+	if (!grown) {
+		printf("\n[!] Failed to grow the hit test table to %d rows.\n", cap);
+		return 0;
+	}
+	for (int c = 0; c < HIT_COLUMNS; c++) {
+		if (row_count) SDL_memcpy(grown + (size_t)cap * c, columns[c], sizeof(Sint32) * row_count);
+		columns[c] = grown + (size_t)cap * c;
+	}
+	__gui_free(table);
+	table = grown;
+	row_cap = cap;
+	return 1;
+}
+
+/* Vectorized test */
+
+// bit per row of the 'HIT_LANES' rows from 'base' that contain the point and have all of 'flags'
+static int __gui_hit_rows(int base, int x, int y, Uint32 flags) {
+#if defined(__AVX2__)
+	__m256i px = _mm256_set1_epi32(x), py = _mm256_set1_epi32(y), want = _mm256_set1_epi32((int)flags);
+	__m256i left = _mm256_loadu_si256((const __m256i *)(columns[HIT_LEFT] + base));
+	__m256i top = _mm256_loadu_si256((const __m256i *)(columns[HIT_TOP] + base));
+	__m256i right = _mm256_loadu_si256((const __m256i *)(columns[HIT_RIGHT] + base));
+	__m256i bottom = _mm256_loadu_si256((const __m256i *)(columns[HIT_BOTTOM] + base));
+	__m256i have = _mm256_loadu_si256((const __m256i *)(columns[HIT_FLAGS] + base));
+
+	// left <= x < right and top <= y < bottom
+	__m256i in = _mm256_andnot_si256(_mm256_cmpgt_epi32(left, px), _mm256_cmpgt_epi32(right, px));
+	in = _mm256_and_si256(in, _mm256_andnot_si256(_mm256_cmpgt_epi32(top, py), _mm256_cmpgt_epi32(bottom, py)));
+	in = _mm256_and_si256(in, _mm256_cmpeq_epi32(_mm256_and_si256(have, want), want));
+	return _mm256_movemask_ps(_mm256_castsi256_ps(in));
+#elif defined(__SSE2__)
+	__m128i px = _mm_set1_epi32(x), py = _mm_set1_epi32(y), want = _mm_set1_epi32((int)flags);
+	__m128i left = _mm_loadu_si128((const __m128i *)(columns[HIT_LEFT] + base));
+	__m128i top = _mm_loadu_si128((const __m128i *)(columns[HIT_TOP] + base));
+	__m128i right = _mm_loadu_si128((const __m128i *)(columns[HIT_RIGHT] + base));
+	__m128i bottom = _mm_loadu_si128((const __m128i *)(columns[HIT_BOTTOM] + base));
+	__m128i have = _mm_loadu_si128((const __m128i *)(columns[HIT_FLAGS] + base));
+
+	__m128i in = _mm_andnot_si128(_mm_cmpgt_epi32(left, px), _mm_cmpgt_epi32(right, px));
+	in = _mm_and_si128(in, _mm_andnot_si128(_mm_cmpgt_epi32(top, py), _mm_cmpgt_epi32(bottom, py)));
+	in = _mm_and_si128(in, _mm_cmpeq_epi32(_mm_and_si128(have, want), want));
+	return _mm_movemask_ps(_mm_castsi128_ps(in));
+#elif defined(__ARM_NEON)
+	int32x4_t px = vdupq_n_s32(x), py = vdupq_n_s32(y);
+	uint32x4_t want = vdupq_n_u32(flags);
+	uint32x4_t have = vreinterpretq_u32_s32(vld1q_s32(columns[HIT_FLAGS] + base));
+
+	uint32x4_t in = vandq_u32(vcleq_s32(vld1q_s32(columns[HIT_LEFT] + base), px), vcgtq_s32(vld1q_s32(columns[HIT_RIGHT] + base), px));
+	in = vandq_u32(in, vandq_u32(vcleq_s32(vld1q_s32(columns[HIT_TOP] + base), py), vcgtq_s32(vld1q_s32(columns[HIT_BOTTOM] + base), py)));
+	in = vandq_u32(in, vceqq_u32(vandq_u32(have, want), want));
+
+	// no movemask on NEON: one bit per lane, then add them up
+	static const Uint32 lane_bits[4] = { 1, 2, 4, 8 };
+	uint32x4_t bits = vandq_u32(in, vld1q_u32(lane_bits));
+	uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+	return (int)vget_lane_u32(vpadd_u32(sum, sum), 0);
+#else
+	return columns[HIT_LEFT][base] <= x && x < columns[HIT_RIGHT][base] &&
+		columns[HIT_TOP][base] <= y && y < columns[HIT_BOTTOM][base] &&
+		((Uint32)columns[HIT_FLAGS][base] & flags) == flags;
+#endif
+}
+
+/* Functions for in-library use only */
+
+// update an element's row (empty bounds or no flags: it can't be hit)
+void __gui_hit_set(int index, const SDL_Rect *bounds, Uint32 flags) {
+	if (index < 0 || !__gui_hit_reserve(index + 1)) return;
+	if (bounds->w <= 0 || bounds->h <= 0) flags = 0;
+
+	columns[HIT_LEFT][index] = bounds->x;
+	columns[HIT_TOP][index] = bounds->y;
+	columns[HIT_RIGHT][index] = bounds->x + bounds->w;
+	columns[HIT_BOTTOM][index] = bounds->y + bounds->h;
+	columns[HIT_FLAGS][index] = (Sint32)flags;
+	if (index >= row_count) row_count = index + 1;
+}
+
+// an element moved to another position in the store (compaction)
+void __gui_hit_move(int from, int to) {
+	if (from >= row_count || to >= row_cap) return;
+	for (int c = 0; c < HIT_COLUMNS; c++) columns[c][to] = columns[c][from];
+}
+
+// forget the rows from 'count' on (the store shrank)
+void __gui_hit_truncate(int count) {
+	if (count < 0) count = 0;
+	for (int i = count; i < row_count; i++) columns[HIT_FLAGS][i] = 0;
+	if (count < row_count) row_count = count;
+}
+
+// topmost (last drawn) element containing the point and having all of 'flags', -1: none
+int __gui_hit_test(int x, int y, Uint32 flags) {
+	if (!flags) flags = GUI_HIT_VISIBLE; 	// rows without flags are never a hit
+
+	// whole vectors, the rows after the last one are zeroed
+	int rows = (row_count + HIT_LANES - 1) / HIT_LANES * HIT_LANES;
+	for (int base = rows - HIT_LANES; base >= 0; base -= HIT_LANES) {
+		int hits = __gui_hit_rows(base, x, y, flags);
+		if (!hits) continue;
+
+		int lane = HIT_LANES - 1;
+		while (!(hits & (1 << lane))) lane--;
+		return base + lane;
+	}
+	return -1;
+}
+
+// release the table (GUI_Quit)
+void __gui_hit_quit() {
+	__gui_free(table);
+	table = NULL;
+	row_count = row_cap = 0;
+}
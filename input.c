@@ -1,6 +1,5 @@
-#include <stdlib.h> // malloc
 #include <stdio.h>  // printf
-#include <string.h> // strncpy, strlen, strcat
+#include <string.h> // memcpy, memmove, strlen
 #include "guilib.h"
 #include "defs.h"
 
@@ -26,23 +25,24 @@ GUI_Input *GUI_CreateInputField(int x, int y, int width, int max_length, char *p
 		return NULL;
 	}
 
-	// allocate text buffer to initialize text field with the max length
-	char *buffer = calloc(max_length + 1, sizeof(char));
+	// allocate text buffer to initialize text field with the max length (freed with the field)
+	char *buffer = __gui_calloc(max_length + 1, 1, GUI_MEM_STRINGS);
 	char *placeholder_valid = NULL;
 	
 	if (placeholder) {
 		// if placeholder text exceeds the character limit (max_length), trim it
 		// this makes a copy of the variable and ensures its value is valid
-		if (strlen(placeholder) > max_length) {
-			placeholder_valid = malloc(max_length + 1);
-			strncpy(placeholder_valid, placeholder, max_length);
-			placeholder_valid[max_length] = '\0'; // null-terminate the string
-		} else {
-			placeholder_valid = strdup(placeholder);
-		}
+		int length = strlen(placeholder) > max_length ? max_length : (int)strlen(placeholder);
+		placeholder_valid = __gui_calloc(length + 1, 1, GUI_MEM_STRINGS);
+		if (placeholder_valid) memcpy(placeholder_valid, placeholder, length); 	// zeroed, stays null-terminated
 	}
 
-	GUI_Input *i = malloc(sizeof(GUI_Input));
+	GUI_Input *i = buffer ? __gui_alloc_element(GUI_INPUT) : NULL;
+	if (!i) {
+		__gui_free(buffer);
+		__gui_free(placeholder_valid);
+		return NULL;
+	}
 
 	*i = (GUI_Input){
 		.tag = NULL,
@@ -57,10 +57,16 @@ GUI_Input *GUI_CreateInputField(int x, int y, int width, int max_length, char *p
 		.max_length = max_length,
 		.text_size = TEXT_SIZE,
 		.caret_visible = 0,
-		.last_blink = 0,
 		.text_offset = 0,
 		.text = NULL,
-		.placeholder = placeholder_valid
+		.placeholder = placeholder_valid,
+		.glyph_x = NULL,
+		.glyph_byte = NULL,
+		.glyph_count = 0,
+		.glyph_cap = 0,
+		.layout_dirty = 1,
+		.layout_hash = 0,
+		.blink_timer = 0
 	};
 
 	i->text = buffer;
@@ -72,22 +78,91 @@ GUI_Input *GUI_CreateInputField(int x, int y, int width, int max_length, char *p
 
 /* Helper functions */
 
+/* caret positions */
+
+// measure every glyph once and store the x offset and byte index of each caret position
+static void __gui_input_rebuild_layout(GUI_Input *input) {
+	GUI_Font *font = GUI_GetFont();
+	int length = strlen(input->text);
+
+	// a string of n bytes has at most n + 1 caret positions
+	if (length + 1 > input->glyph_cap) {
+		int cap = input->glyph_cap ? input->glyph_cap : 16;
+		while (cap < length + 1) cap *= 2;
+
+		int *glyph_x = __gui_realloc(input->glyph_x, sizeof(int) * cap, GUI_MEM_ELEMENTS);
+		if (glyph_x) input->glyph_x = glyph_x;
+		int *glyph_byte = __gui_realloc(input->glyph_byte, sizeof(int) * cap, GUI_MEM_ELEMENTS);
+		if (glyph_byte) input->glyph_byte = glyph_byte;
+		if (!glyph_x || !glyph_byte) return;
+
+		input->glyph_cap = cap;
+	}
+
+	const char *p = input->text;
+	const char *end = input->text + length;
+	Uint32 prev = 0;
+	int x = 0, count = 0;
+
+	input->glyph_x[count] = 0;
+	input->glyph_byte[count++] = 0;
+
+	while (p < end) {
+		Uint32 ch = __gui_utf8_decode(&p, end);
+		x += __gui_text_advance(font, prev, ch);
+		prev = ch;
+
+		input->glyph_x[count] = x;
+		input->glyph_byte[count++] = (int)(p - input->text);
+	}
+	input->glyph_count = count;
+	input->layout_hash = __gui_hash_bytes(GUI_HASH_INIT, input->text, length);
+	input->layout_dirty = 0;
+}
+
+static void __gui_input_sync_layout(GUI_Input *input) {
+	if (input->layout_dirty || !input->glyph_count)
+		__gui_input_rebuild_layout(input);
+}
+
+// index of the caret position at or after a byte index (binary search)
+static int __gui_input_caret_index(GUI_Input *input, int byte) {
+	int lo = 0, hi = input->glyph_count - 1;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (input->glyph_byte[mid] < byte) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+// byte index of the previous and next caret positions (whole UTF-8 characters)
+static int __gui_input_prev_char(GUI_Input *input, int byte) {
+	__gui_input_sync_layout(input);
+	int i = __gui_input_caret_index(input, byte);
+	return i > 0 ? input->glyph_byte[i - 1] : 0;
+}
+
+static int __gui_input_next_char(GUI_Input *input, int byte) {
+	__gui_input_sync_layout(input);
+	int i = __gui_input_caret_index(input, byte);
+	return i < input->glyph_count - 1 ? input->glyph_byte[i + 1] : input->glyph_byte[input->glyph_count - 1];
+}
+
 /* cursor (caret) reading and positioning */
 
-int __gui_get_cursor_position(const char *text, int cursor_pos) {
-	if (!text || !*text) return 0; 		// NULL pointer or empty string
+int __gui_get_cursor_position(GUI_Input *input) {
+	if (!input->text || !*input->text) return 0; 	// NULL pointer or empty string
 
-	char buffer[256];
-	strncpy(buffer, text, cursor_pos); 	// copy text into buffer up until the cursor position
-	buffer[cursor_pos] = '\0'; 			// null-terminate the string
+	__gui_input_sync_layout(input);
+	if (!input->glyph_count) return 0;
 
-	int offset = 0; 					// store pixel width of the substring
-	TTF_SizeUTF8(default_font, buffer, &offset, NULL);
-	return offset; 						// return cursor offset within the text
+	// pixel width of the text up until the cursor position
+	return input->glyph_x[__gui_input_caret_index(input, input->cursor_pos)];
 }
 
 void __gui_update_cursor_position(GUI_Input *input) {
-	int caret_x = __gui_get_cursor_position(input->text, input->cursor_pos);
+	int caret_x = __gui_get_cursor_position(input);
 	int max_width = input->width - 2 * PADDING; // determine how much text can fit within the field
 
 	// scroll text if the caret goes out of bounds
@@ -100,44 +175,60 @@ void __gui_update_cursor_position(GUI_Input *input) {
 void __gui_place_caret(GUI_Input *input, int mx) {
 	if (!input || !input->text || !*input->text) return;  // NULL pointers or empty string
 
-	int cursor_pos = mx - input->x + input->text_offset;  // relative position within the field
-	int pos = 0, text_width = 0;
+	__gui_input_sync_layout(input);
+	if (!input->glyph_count) return;
 
-	// process text one character at a time
-	while (input->text[pos]) {
-		int char_width = 0;
+	int cursor_x = mx - input->x - PADDING + input->text_offset;  // relative position within the text
 
-		// measure character width (UTF-8)
-		char c[2] = { input->text[pos], '\0' };
-		TTF_SizeUTF8(default_font, c, &char_width, NULL);
+	// binary search for the first caret position right of the cursor
+	int lo = 0, hi = input->glyph_count - 1;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (input->glyph_x[mid] < cursor_x) lo = mid + 1;
+		else hi = mid;
+	}
+	// snap to whichever side of the character is closer
+	if (lo > 0 && cursor_x - input->glyph_x[lo - 1] < input->glyph_x[lo] - cursor_x)
+		lo--;
 
-		// stop iterating if cursor is on the character
-		if (text_width + char_width / 2 >= cursor_pos) break;
+	input->cursor_pos = input->glyph_byte[lo];
+}
 
-		text_width += char_width;
-		pos++;
-	}
-	input->cursor_pos = pos;
+// periodic timer toggling the caret's visibility
+static void __gui_input_blink(void *args) {
+	GUI_Input *input = (GUI_Input *)args;
+	input->caret_visible = !input->caret_visible;
 }
 
-void __gui_draw_caret(SDL_Renderer *renderer, GUI_Input *input) {
-	Uint32 time_now = SDL_GetTicks();
+// show the caret and blink every 500 ms from now on
+static void __gui_input_restart_blink(GUI_Input *input) {
+	GUI_CancelTimer(input->blink_timer);
+	input->caret_visible = 1;
+	input->blink_timer = GUI_AddTimer(CARET_BLINK_MS, CARET_BLINK_MS, __gui_input_blink, input);
+}
 
-	// blink every 500 ms
-	if (time_now - input->last_blink >= CARET_BLINK_MS) {
-		input->caret_visible = !input->caret_visible;
-		input->last_blink = time_now;
+// blink while in focus (also evaluated before rendering, the focus can be changed from outside)
+void __gui_input_update_caret(GUI_Input *input) {
+	if (input->focus && !input->blink_timer) {
+		__gui_input_restart_blink(input);
+	} else if (!input->focus && input->blink_timer) {
+		GUI_CancelTimer(input->blink_timer);
+		input->blink_timer = 0;
 	}
+}
 
+void __gui_draw_caret(GUI_Input *input) {
+	__gui_input_update_caret(input);
 	if (!input->caret_visible) return;
 
 	// get caret's position within the input field and clamp it
-	int caret_x = input->x + PADDING + __gui_get_cursor_position(input->text, input->cursor_pos) - input->text_offset;
+	int caret_x = input->x + PADDING + __gui_get_cursor_position(input) - input->text_offset;
 	caret_x = SDL_clamp(caret_x, input->x, input->x + input->width - PADDING);
 
 	// draw the caret
-	SDL_SetRenderDrawColor(renderer, SET_COLOR_TEXT_ENABLED);
-	SDL_RenderDrawLine(renderer, caret_x, input->y + PADDING, caret_x, input->y + CARET_HEIGHT + PADDING);
+	SDL_Rect caret_rect = { caret_x, input->y + PADDING, 1, CARET_HEIGHT + 1 };
+	__gui_set_color(SET_COLOR_TEXT_ENABLED);
+	__gui_fill_rect(&caret_rect);
 }
 
 /* Word scanning for Ctrl key modifier */
@@ -176,7 +267,9 @@ static int __gui_next_word_pos(const char *text, int cursor_pos) {
 void GUI_RenderInput(GUI_Input *input) {
 	if (!input || !input->visible) return;
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
+	// the text may have been changed from outside the library
+	if (input->text && __gui_hash_bytes(GUI_HASH_INIT, input->text, strlen(input->text)) != input->layout_hash)
+		input->layout_dirty = 1;
 
 	// input field body
 	SDL_Rect input_rect = { input->x, input->y, input->width, input->height };
@@ -185,8 +278,8 @@ void GUI_RenderInput(GUI_Input *input) {
 
 	// light up the box when in focus
 	SDL_Color color = input->focus ? current_theme->input_active : current_theme->input_inactive;
-	SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-	SDL_RenderFillRect(renderer, &input_rect);
+	__gui_set_color(color.r, color.g, color.b, color.a);
+	__gui_fill_rect(&input_rect);
 
 	// set text colors
 	SDL_Color text_color = { SET_COLOR_TEXT_ENABLED };
@@ -199,7 +292,7 @@ void GUI_RenderInput(GUI_Input *input) {
 		__gui_render_text_clipped(input->placeholder, &input_rect, input->text_offset, placeholder_color);
 
 	if (input->focus)
-		__gui_draw_caret(renderer, input);
+		__gui_draw_caret(input);
 }
 
 static void __gui_process_input_field(SDL_Event *event, GUI_Input *input, int mx, int my) {
@@ -226,6 +319,7 @@ static void __gui_process_input_field(SDL_Event *event, GUI_Input *input, int mx
 			// insert new characters at cursor (caret) position
 			memcpy(input->text + input->cursor_pos, event->text.text, added_len);
 			input->cursor_pos += added_len;
+			input->layout_dirty = 1;
 		}
 	}
 	// handle special key presses
@@ -240,7 +334,7 @@ static void __gui_process_input_field(SDL_Event *event, GUI_Input *input, int mx
 				if (input->cursor_pos > 0) {
 					// shift input array to the left by one character
 					// if ctrl is held, shift by whole word
-					int new_pos = ctrl ? __gui_prev_word_pos(input->text, input->cursor_pos) : input->cursor_pos - 1;
+					int new_pos = ctrl ? __gui_prev_word_pos(input->text, input->cursor_pos) : __gui_input_prev_char(input, input->cursor_pos);
 
 					// shift memory to the left, overwriting the deleted character(s)
 					memmove(input->text + new_pos,
@@ -248,6 +342,7 @@ static void __gui_process_input_field(SDL_Event *event, GUI_Input *input, int mx
 							strlen(input->text + input->cursor_pos) + 1);
 
 					input->cursor_pos = new_pos;
+					input->layout_dirty = 1;
 				}
 				break;
 
@@ -256,12 +351,13 @@ static void __gui_process_input_field(SDL_Event *event, GUI_Input *input, int mx
 				int input_len = strlen(input->text);
 
 				if (input->cursor_pos < input_len) {
-					int del_end = ctrl ? __gui_next_word_pos(input->text, input->cursor_pos) : input->cursor_pos + 1;
+					int del_end = ctrl ? __gui_next_word_pos(input->text, input->cursor_pos) : __gui_input_next_char(input, input->cursor_pos);
 
 					// shift memory to the left
 					memmove(input->text + input->cursor_pos,
 							input->text + del_end,
 							input_len - del_end + 1);
+					input->layout_dirty = 1;
 				}
 				break;
 			}
@@ -271,7 +367,7 @@ static void __gui_process_input_field(SDL_Event *event, GUI_Input *input, int mx
 				if (ctrl)
 					input->cursor_pos = __gui_prev_word_pos(input->text, input->cursor_pos);
 				else if (input->cursor_pos > 0)
-					input->cursor_pos--;
+					input->cursor_pos = __gui_input_prev_char(input, input->cursor_pos);
 				break;
 
 			// move cursor right
@@ -279,7 +375,7 @@ static void __gui_process_input_field(SDL_Event *event, GUI_Input *input, int mx
 				if (ctrl)
 					input->cursor_pos = __gui_next_word_pos(input->text, input->cursor_pos);
 				else if (input->cursor_pos < strlen(input->text))
-					input->cursor_pos++;
+					input->cursor_pos = __gui_input_next_char(input, input->cursor_pos);
 				break;
 
 			// bring cursor to the start of input
@@ -302,11 +398,11 @@ static void __gui_process_input_field(SDL_Event *event, GUI_Input *input, int mx
 				input->text[0] = '\0';
 				input->cursor_pos = 0;
 				input->focus = 0;
+				input->layout_dirty = 1;
 				break;
 		}
 		__gui_update_cursor_position(input);
-		input->caret_visible = 1;
-		input->last_blink = SDL_GetTicks(); // keep caret from blinking while typing
+		if (input->focus) __gui_input_restart_blink(input); // keep caret from blinking while typing
 	}
 	else if (event->type == SDL_MOUSEBUTTONDOWN)
 		__gui_place_caret(input, mx); 		// place caret inside text on click
@@ -1,6 +1,5 @@
-#include <stdlib.h>  // malloc
 #include <stdio.h>   // printf
-#include <string.h>  // strdup, strtok
+#include <string.h>  // strchr, strlen
 #include <SDL2/SDL_ttf.h>
 #include "guilib.h"
 #include "defs.h"
@@ -10,16 +9,29 @@
 
 // TODO:
 // allow anti-aliasing toggle: use TTF_RenderText_Solid() for pixelated text
-// bold, italics, underlined text
 
 // basic label
 GUI_Label *GUI_CreateLabel(int x, int y, char *text) {
-	GUI_Label *l = malloc(sizeof(GUI_Label));
-    *l = (GUI_Label){ NULL, x, y, VISIBLE, text, {0}, NULL };
-
-	l->font = TTF_OpenFont(LIBERATION_SANS, TEXT_SIZE);
-	if (!l->font)
-		printf("\n[!] Failed to load label font: %s\n", TTF_GetError());
+	GUI_Label *l = __gui_alloc_element(GUI_LABEL); 	// from the current screen's pool (pool.c)
+	if (!l) return NULL;
+	*l = (GUI_Label){
+		.tag = NULL,
+		.x = x,
+		.y = y,
+		.visible = VISIBLE,
+		.text = text,
+		.color = {0},
+		.font = NULL,
+		.style = TTF_STYLE_NORMAL,
+		.layout_hash = 0,
+		.layout_font = NULL,
+		.line_count = 0,
+		.line_cap = 0,
+		.lines = NULL
+	};
+
+	// shared with every other label of the same font and size (prints an error on failure)
+	l->font = GUI_OpenFont(LIBERATION_SANS, TEXT_SIZE);
 
 	// add to general list of elements for simplified processing
 	__gui_add_element(GUI_LABEL, l, (void (*)(void*))GUI_RenderLabel, NULL);
@@ -28,29 +40,115 @@ GUI_Label *GUI_CreateLabel(int x, int y, char *text) {
 
 // extended label: includes color, font, text size
 GUI_Label *GUI_CreateLabelEx(int x, int y, char *text, const char *font_path, int text_size) {
-	GUI_Label *l = malloc(sizeof(GUI_Label));
-    *l = (GUI_Label){ NULL, x, y, VISIBLE, text, {0}, NULL };
-
-	l->font = TTF_OpenFont(font_path, text_size);
-	if (!l->font)
-		printf("\n[!] Failed to load label font: %s\n", TTF_GetError());
+	GUI_Label *l = __gui_alloc_element(GUI_LABEL);
+	if (!l) return NULL;
+	*l = (GUI_Label){
+		.tag = NULL,
+		.x = x,
+		.y = y,
+		.visible = VISIBLE,
+		.text = text,
+		.color = {0},
+		.font = NULL,
+		.style = TTF_STYLE_NORMAL,
+		.layout_hash = 0,
+		.layout_font = NULL,
+		.line_count = 0,
+		.line_cap = 0,
+		.lines = NULL
+	};
+
+	l->font = GUI_OpenFont(font_path, text_size);
 
 	__gui_add_element(GUI_LABEL, l, (void (*)(void*))GUI_RenderLabel, NULL);
 	return l;
 }
 
-void GUI_RenderLabel(GUI_Label *label) {
-	if (!label || !label->font || !label->visible) return; // NULL pointer, missing font, hidden element
+/* Layout */
+
+static void __gui_label_clear_layout(GUI_Label *label) {
+	for (int i = 0; i < label->line_count; i++)
+		__gui_text_cache_release(label->lines[i].texture);
+
+	label->line_count = 0;
+	label->width = label->height = 0;
+}
+
+// split text into lines by newline '\n' characters and render each line once (in white, tinted when drawn)
+static void __gui_label_build_layout(GUI_Label *label, Uint32 hash) {
+	__gui_label_clear_layout(label);
+
+	const char *text = label->text;
+	const char *line = text;
+
+	while (*line) {
+		const char *line_end = strchr(line, '\n');
+		int length = line_end ? (int)(line_end - line) : (int)strlen(line);
+
+		// empty lines are skipped, same as strtok() would
+		if (length > 0) {
+			if (label->line_count == label->line_cap) {
+				int cap = label->line_cap ? label->line_cap * 2 : 4;
+				GUI_LabelLine *lines = __gui_realloc(label->lines, sizeof(GUI_LabelLine) * cap, GUI_MEM_ELEMENTS);
+				if (!lines) break;
+				label->lines = lines;
+				label->line_cap = cap;
+			}
+
+			GUI_LabelLine *l = &label->lines[label->line_count];
+			*l = (GUI_LabelLine){ (int)(line - text), length, 0, 0, NULL };
+
+			// SDF sizes and baked fonts have no rasterizer of their own, they're drawn from the glyph atlas
+			// (without the label's style, the atlas holds the plain glyphs only)
+			if (!label->font->ttf) {
+				__gui_text_size(label->font, line, length, &l->width, &l->height);
+			} else {
+				l->texture = __gui_text_cache_acquire(label->font, line, length, label->style);
+				__gui_text_cache_texture(l->texture, &l->width, &l->height);
+			}
+
+			if (l->texture || !label->font->ttf) {
+				if (l->width > label->width) label->width = l->width;
+				label->height += l->height;
+				label->line_count++;
+			}
+		}
+		if (!line_end) break;
+		line = line_end + 1;
+	}
+
+	label->layout_hash = hash;
+	label->layout_font = label->font;
+	label->layout_style = label->style;
+}
+
+// bring the layout up to date with the text and refresh the size of lines that were still being rasterized;
+// returns the number of lines still waiting for their texture
+int __gui_label_update_layout(GUI_Label *label) {
+	if (!label || !label->font || !label->text) return 0;
+
+	// the text buffer may be rewritten in place, so compare contents rather than the pointer
+	Uint32 hash = __gui_hash_bytes(GUI_HASH_INIT, label->text, strlen(label->text));
+
+	if (hash != label->layout_hash || label->font != label->layout_font || label->style != label->layout_style || !label->layout_font)
+		__gui_label_build_layout(label, hash);
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
-	
-	SDL_Surface *surface;
-	SDL_Texture *texture;
+	int pending = 0;
+	label->width = label->height = 0;
 
-	char *text_cpy = strdup(label->text); 	// duplicate of the label text
+	for (int i = 0; i < label->line_count; i++) {
+		GUI_LabelLine *line = &label->lines[i];
+		if (line->texture && !__gui_text_cache_texture(line->texture, &line->width, &line->height))
+			pending++;
 
-	int line_y = label->y; 					// position to start rendering new lines from
-	char *line = strtok(text_cpy, "\n"); 	// split text into tokens (substrings) by newline '\n' characters
+		if (line->width > label->width) label->width = line->width;
+		label->height += line->height;
+	}
+	return pending;
+}
+
+void GUI_RenderLabel(GUI_Label *label) {
+	if (!label || !label->font || !label->visible || !label->text) return; // NULL pointer, missing font, hidden element
 
 	SDL_Color text_color;
 
@@ -60,26 +158,48 @@ void GUI_RenderLabel(GUI_Label *label) {
 	else
 		text_color = current_theme->text_enabled;
 
-	while (line) {
-		// create text surface and texture
-		surface = TTF_RenderUTF8_Blended(label->font, line, text_color);
-		texture = SDL_CreateTextureFromSurface(renderer, surface);
+	__gui_label_update_layout(label);
 
-		SDL_Rect label_rect = { label->x, line_y, surface->w, surface->h }; // text bounding box
-		SDL_RenderCopy(renderer, texture, NULL, &label_rect); 				// render text
+	int line_y = label->y; 	// position to start rendering new lines from
 
-		line_y += surface->h; 		// move to next line
-		line = strtok(NULL, "\n"); 	// pointer to next token (next line of text)
-		
-		SDL_FreeSurface(surface); 	// clean up
-		SDL_DestroyTexture(texture);
+	for (int i = 0; i < label->line_count; i++) {
+		GUI_LabelLine *line = &label->lines[i];
+
+		if (line->texture) {
+			// lines still being rasterized keep their space empty until the texture is uploaded
+			SDL_Texture *texture = __gui_text_cache_texture(line->texture, NULL, NULL);
+			SDL_Rect label_rect = { label->x, line_y, line->width, line->height }; // text bounding box
+
+			// cached lines are white, the copy tints them (the texture may be shared with differently colored labels)
+			if (texture) __gui_render_copy(texture, NULL, &label_rect, text_color);
+		} else {
+			__gui_text_draw(label->font, label->text + line->start, line->length, label->x, line_y, text_color);
+		}
+		line_y += line->height; // move to next line
 	}
-	free(text_cpy);
+}
+
+// change the text size, with SDF text enabled this only rescales the shared glyphs
+void GUI_SetLabelTextSize(GUI_Label *label, int size) {
+	if (!label || !label->font || label->font->size == size) return;
+
+	GUI_Font *font = GUI_OpenFont(label->font->path, size);
+	if (!font) return;
+
+	GUI_CloseFont(label->font);
+	label->font = font; 	// layout is rebuilt on the next render
 }
 
 void GUI_DestroyLabel(GUI_Label *label) {
+	if (!label) return;
+
+	__gui_label_clear_layout(label);
+	__gui_free(label->lines);
+	label->lines = NULL;
+	label->line_cap = 0;
+
 	if (label->font) {
-		TTF_CloseFont(label->font);
+		GUI_CloseFont(label->font); 	// the font is closed once no other label uses it
 		label->font = NULL;
 	}
-}
\ No newline at end of file
+}
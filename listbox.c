@@ -1,5 +1,3 @@
-#include <stdlib.h> // malloc
-#include <SDL2/SDL2_gfxPrimitives.h>
 #include "guilib.h"
 #include "defs.h"
 
@@ -7,6 +5,8 @@
 #define ENTRY_HEIGHT 		22
 #define BORDER_WIDTH 		1
 #define MAX_VISIBLE 		4
+#define TEXT_PADDING 		4
+#define ARROW_AREA 			18 		// space kept free for the expand/collapse arrow
 #define COLLAPSED 			0
 #define EXPANDED 			1
 
@@ -17,7 +17,8 @@
 static void __gui_process_listbox(SDL_Event *event, GUI_ListBox *listbox, int mx, int my);
 
 GUI_ListBox *GUI_CreateListBox(int x, int y, const char *placeholder, void (*on_select)(void*)) {
-	GUI_ListBox *lb = malloc(sizeof(GUI_ListBox));
+	GUI_ListBox *lb = __gui_alloc_element(GUI_LISTBOX);
+	if (!lb) return NULL;
 
 	*lb = (GUI_ListBox){
 		.tag = NULL,
@@ -62,7 +63,18 @@ GUI_ListBox *GUI_CreateListBox(int x, int y, const char *placeholder, void (*on_
 void GUI_AddListEntry(GUI_ListBox *lb, const char *text) {
 	if (!lb) return;
 
-	lb->entries = realloc(lb->entries, sizeof(GUI_ListEntry) * (lb->entry_count + 1));
+	// grow by doubling, entries are usually added one at a time
+	if (lb->entry_count == lb->entry_cap) {
+		int cap = lb->entry_cap ? lb->entry_cap * 2 : 8;
+		GUI_ListEntry *entries = __gui_realloc(lb->entries, sizeof(GUI_ListEntry) * cap, GUI_MEM_LIST_ENTRIES);
+		if (!entries) return;
+
+		// selection pointers point into the array
+		if (lb->selected_entry) lb->selected_entry = entries + (lb->selected_entry - lb->entries);
+		if (lb->highlighted_entry) lb->highlighted_entry = entries + (lb->highlighted_entry - lb->entries);
+		lb->entries = entries;
+		lb->entry_cap = cap;
+	}
 	lb->entries[lb->entry_count++] = (GUI_ListEntry){ text };
 }
 
@@ -70,8 +82,10 @@ void GUI_AddListEntry(GUI_ListBox *lb, const char *text) {
 void GUI_SetListEntries(GUI_ListBox *lb, const char **texts, int count) {
 	if (!lb) return; // NULL pointer
 
-	free(lb->entries);
-	lb->entries = malloc(sizeof(GUI_ListEntry) * count);
+	__gui_free(lb->entries);
+	lb->entries = __gui_malloc(sizeof(GUI_ListEntry) * count, GUI_MEM_LIST_ENTRIES);
+	lb->entry_cap = lb->entries ? count : 0;
+	if (!lb->entries) count = 0;
 	for (int i = 0; i < count; i++)
 		lb->entries[i] = (GUI_ListEntry){ texts[i] };
 
@@ -92,27 +106,21 @@ void GUI_SelectListEntry(GUI_ListBox *lb, int index) {
 }
 
 static void __gui_render_display_arrow(GUI_ListBox *lb) {
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
-	Uint32 arrow_color = __gui_color_to_uint32(SET_COLOR_SCROLLBAR_BUTTON_NORMAL); // convert SDL_Color to Uint32
 	int cx, cy; // center point coordinates
 
 	cx = lb->x + lb->width - 10;
 	cy = lb->y + lb->entry_height / 2;
 
-	if (!lb->expanded) { 	// collapsed list: arrow points right
-		aalineColor(renderer, cx - 4, cy - 2, cx, cy + 3, arrow_color); // SDL2_gfx
-		aalineColor(renderer, cx + 4, cy - 2, cx, cy + 3, arrow_color);
-	} else { 				// expanded list: arrow points down
-		aalineColor(renderer, cx - 1, cy - 4, cx + 4, cy, arrow_color);
-		aalineColor(renderer, cx - 1, cy + 4, cx + 4, cy, arrow_color);
-	}
+	__gui_set_color(SET_COLOR_SCROLLBAR_BUTTON_NORMAL);
+	if (!lb->expanded) 	// collapsed list: arrow points down
+		__gui_draw_sprite(GUI_SPRITE_ARROW_DOWN, 0, cx, cy);
+	else 				// expanded list: arrow points right
+		__gui_draw_sprite(GUI_SPRITE_ARROW_RIGHT, 0, cx, cy);
 }
 
 void GUI_RenderListBox(GUI_ListBox *listbox) {
 	if (!listbox || !listbox->visible) return; // NULL pointer, disabled or hidden element
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
 	
 	int rect_x = listbox->x;
 	int rect_y = listbox->y;
@@ -133,11 +141,11 @@ void GUI_RenderListBox(GUI_ListBox *listbox) {
 
 	// main rect; always visible and displays current selection or placeholder text
 	SDL_Rect display_rect = { rect_x, rect_y, rect_w, rect_h };
-	SDL_SetRenderDrawColor(renderer, SET_COLOR_NORMAL);
-	SDL_RenderFillRect(renderer, &display_rect);
+	__gui_set_color(SET_COLOR_NORMAL);
+	__gui_fill_rect(&display_rect);
 	
-	// selected entry or placeholder text
-	SDL_Rect text_rect = { rect_x + 4, rect_y, rect_w - 4, rect_h };
+	// selected entry or placeholder text, cut short before the arrow
+	SDL_Rect text_rect = { rect_x + TEXT_PADDING, rect_y, rect_w - TEXT_PADDING - ARROW_AREA, rect_h };
 	__gui_render_text(display_text, &text_rect, text_color);
 	
 	// expand/collapse arrow
@@ -150,23 +158,31 @@ void GUI_RenderListBox(GUI_ListBox *listbox) {
 	int end = start + listbox->max_visible;
 	if (end > listbox->entry_count) end = listbox->entry_count;
 
+	// entry text must not run under the scrollbar, and the entry isn't filled under it either
+	int text_w = rect_w - TEXT_PADDING * 2;
+	int entry_w = rect_w;
+	if (listbox->entry_count > listbox->max_visible) {
+		text_w -= listbox->scrollbar.width;
+		entry_w -= listbox->scrollbar.width;
+	}
+
 	for (int i = start; i < end; i++) {
 		GUI_ListEntry *entry = &listbox->entries[i];
 
 		int entry_y = rect_y + (i - start + 1) * rect_h;
-		SDL_Rect entry_rect = { rect_x, entry_y, rect_w, rect_h };
+		SDL_Rect entry_rect = { rect_x, entry_y, entry_w, rect_h };
 
 		// set color
 		if (entry == listbox->highlighted_entry)
-			SDL_SetRenderDrawColor(renderer, SET_COLOR_ENTRY_SELECTED);
+			__gui_set_color(SET_COLOR_ENTRY_SELECTED);
 		else
-			SDL_SetRenderDrawColor(renderer, SET_COLOR_ENTRY_NORMAL);
+			__gui_set_color(SET_COLOR_ENTRY_NORMAL);
 
-		SDL_RenderFillRect(renderer, &entry_rect);
+		__gui_fill_rect(&entry_rect);
 
 		// entry text
 		if (entry->text && *entry->text) {
-			SDL_Rect text_rect = { entry_rect.x + 4, entry_rect.y, rect_w - 4, rect_h };
+			SDL_Rect text_rect = { entry_rect.x + TEXT_PADDING, entry_rect.y, text_w, rect_h };
 			__gui_render_text(entry->text, &text_rect, text_color);
 		}
 	}
@@ -175,6 +191,22 @@ void GUI_RenderListBox(GUI_ListBox *listbox) {
 		__gui_render_scrollbar(&listbox->scrollbar);
 }
 
+// area an expanded list paints completely (display row and entries, not the scrollbar);
+// returns 0 if it's collapsed or the theme's colors are translucent
+int __gui_listbox_opaque_rect(GUI_ListBox *listbox, SDL_Rect *rect) {
+	if (!listbox->visible || !listbox->expanded) return 0;
+	if (current_theme->content_normal.a != 255 || current_theme->list_entry_normal.a != 255 ||
+		current_theme->list_entry_selected.a != 255) return 0;
+
+	int visible_entries = (listbox->entry_count < listbox->max_visible)
+						 ? listbox->entry_count : listbox->max_visible;
+	int entry_w = listbox->width;
+	if (listbox->entry_count > listbox->max_visible) entry_w -= listbox->scrollbar.width;
+
+	*rect = (SDL_Rect){ listbox->x, listbox->y, entry_w, listbox->entry_height * (visible_entries + 1) };
+	return 1;
+}
+
 static void __gui_process_listbox(SDL_Event *event, GUI_ListBox *listbox, int mx, int my) {
 	if (!listbox || !listbox->visible) return; // NULL pointer, disabled or hidden element
 	
@@ -216,40 +248,36 @@ static void __gui_process_listbox(SDL_Event *event, GUI_ListBox *listbox, int mx
 
 	if (end > listbox->entry_count)
 		end = listbox->entry_count;
+	if (start >= end) return; 	// no entries
 	
 	int in_scrollbar =  SDL_PointInRect(&mouse, &listbox->scrollbar.up_button)  ||
 						SDL_PointInRect(&mouse, &listbox->scrollbar.down_button);
 
-	// loop through entries
-	for (int i = start; i < end; i++) {
-		GUI_ListEntry *entry = &listbox->entries[i];
-		int entry_y = rect_y + (i - start + 1) * rect_h;
-		SDL_Rect entry_rect = { rect_x, entry_y, rect_w, rect_h };
+	// entries are rows of equal height below the display box, the one under the cursor follows from its position
+	int hovered = -1;
+	int list_y = rect_y + rect_h;
+	if (mx >= rect_x && mx < rect_x + rect_w && my >= list_y && rect_h > 0) {
+		int i = start + (my - list_y) / rect_h;
+		if (i < end) hovered = i;
+	}
 
-		int intersect = SDL_PointInRect(&mouse, &entry_rect);
+	// highlight hovered entry
+	if (hovered >= 0 && !in_scrollbar)
+		listbox->highlighted_entry = &listbox->entries[hovered];
 
-		// highlight hovered entry
-		if (intersect && !in_scrollbar)
-			listbox->highlighted_entry = entry;
+	if (event->type != SDL_MOUSEBUTTONDOWN) return;
 
-		// single entry select: on click, overwrite the selected entry value
-		if (event->type == SDL_MOUSEBUTTONDOWN && event->button.button == SDL_BUTTON_LEFT && intersect) {
-			if (listbox->selected_id == i) {
-				listbox->expanded = COLLAPSED;
-				break;
-			}
-			listbox->selected_id = i;
-			listbox->selected_entry = entry;
-			listbox->highlighted_entry = entry;
-			listbox->expanded = COLLAPSED;
+	// when clicked outside, collapse the list
+	listbox->expanded = COLLAPSED;
 
-			if (listbox->on_select)
-				listbox->on_select(listbox->args); // execute optional callback function
+	// single entry select: on click, overwrite the selected entry value
+	if (event->button.button == SDL_BUTTON_LEFT && hovered >= 0 && listbox->selected_id != hovered) {
+		GUI_ListEntry *entry = &listbox->entries[hovered];
+		listbox->selected_id = hovered;
+		listbox->selected_entry = entry;
+		listbox->highlighted_entry = entry;
 
-			break;
-		}
-		// when clicked outside, collapse the list
-		else if (event->type == SDL_MOUSEBUTTONDOWN && !intersect)
-			listbox->expanded = COLLAPSED;
+		if (listbox->on_select)
+			listbox->on_select(listbox->args); // execute optional callback function
 	}
 }
\ No newline at end of file
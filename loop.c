@@ -0,0 +1,137 @@
+/*
+	Run loop. Instead of polling and redrawing at a fixed rate,
+	the loop blocks in SDL_WaitEventTimeout until either input
+	arrives or something on screen is due to change by itself
+	(a timer or tween of the scheduler, a frame requested with
+	GUI_RequestFrame). A window with nothing going on sleeps
+	between events and uses next to no CPU.
+
+	Frames are presented only when GUI_IsDirty reports damage.
+	With vsync (GUI_SetVSync) SDL_RenderPresent paces running
+	animations, without it they're stepped every FRAME_INTERVAL.
+*/
+
+#include <stdio.h>  // printf
+#include <SDL2/SDL.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define FRAME_INTERVAL 		16 		// ms between animation frames without vsync (~60 FPS)
+
+static int quit = 0;
+static int vsync = 0;
+static int presented = 0; 		// the last iteration rendered a frame (and waited for vsync doing so)
+static void (*frame_callback)(void *args) = NULL;
+static void *frame_args = NULL;
+
+static Uint32 wake_event = (Uint32)-1; 	// pushed to end a wait early (GUI_RequestFrame(0))
+static int has_deadline = 0; 				// a frame was requested for a later time
+static Uint32 deadline = 0;
+
+// register the event type that wakes up the loop
+static Uint32 __gui_wake_event() {
+	if (wake_event == (Uint32)-1) wake_event = SDL_RegisterEvents(1);
+	return wake_event;
+}
+
+// milliseconds until the loop has to run again (-1: only when an event arrives)
+static int __gui_wait_time() {
+	if (GUI_IsDirty()) return 0; 	// e.g. the first frame, or elements changed outside of the loop
+
+	// SDL_RenderPresent only paces the loop when a frame is presented, an animation that
+	// changes no pixels this frame would spin without a wait of its own
+	Uint32 frame_interval = vsync && presented ? 0 : FRAME_INTERVAL;
+	int next = __gui_next_deadline(frame_interval);
+
+	// timers and tweens (caret blink, progress bar easing, user timers)
+	int timer = __gui_scheduler_next_deadline(frame_interval);
+	if (timer >= 0 && (next < 0 || timer < next)) next = timer;
+
+	if (has_deadline) {
+		Sint32 until = (Sint32)(deadline - SDL_GetTicks());
+		if (until < 0) until = 0;
+		if (next < 0 || until < next) next = until;
+	}
+	return next;
+}
+
+static void __gui_dispatch(SDL_Event *event) {
+	if (event->type == SDL_QUIT) quit = 1;
+	else if (event->type == wake_event) return; 	// only there to end the wait
+	GUI_ProcessEvents(event);
+}
+
+/* Public functions */
+
+// function called once per loop iteration, after events and before rendering (update labels etc. here)
+void GUI_SetFrameCallback(void (*on_frame)(void *args), void *args) {
+	frame_callback = on_frame;
+	frame_args = args;
+}
+
+// run the loop again after 'delay_ms' (0: as soon as possible, safe to call from other threads)
+void GUI_RequestFrame(Uint32 delay_ms) {
+	if (delay_ms == 0) {
+		Uint32 type = __gui_wake_event();
+		if (type == (Uint32)-1) return;
+
+		SDL_Event event = { .type = type };
+		SDL_PushEvent(&event);
+		return;
+	}
+	Uint32 when = SDL_GetTicks() + delay_ms;
+	if (!has_deadline || (Sint32)(when - deadline) < 0) deadline = when;
+	has_deadline = 1;
+}
+
+// let SDL_RenderPresent wait for the display's refresh (paces animations)
+void GUI_SetVSync(int enable) {
+	if (SDL_RenderSetVSync(GUI_GetRenderer(), enable ? 1 : 0) != 0) {
+		printf("\n[!] Failed to set vsync: %s\n", SDL_GetError());
+		enable = 0;
+	}
+	vsync = enable;
+}
+
+// make GUI_Run return after the current frame
+void GUI_StopRunning() {
+	quit = 1;
+	GUI_RequestFrame(0);
+}
+
+// wait for events (at most 'timeout_ms', -1: until the next deadline), process them and render if needed
+// returns 0 once the window was closed
+int GUI_PumpFrame(int timeout_ms) {
+	SDL_Event event;
+	__gui_wake_event();
+
+	int wait = __gui_wait_time();
+	if (timeout_ms >= 0 && (wait < 0 || timeout_ms < wait)) wait = timeout_ms;
+
+	// block until something happens, then drain the queue
+	int has_event = wait < 0 ? SDL_WaitEvent(&event) : SDL_WaitEventTimeout(&event, wait);
+	if (has_event) __gui_dispatch(&event);
+	while (SDL_PollEvent(&event))
+		__gui_dispatch(&event);
+
+	if (has_deadline && (Sint32)(SDL_GetTicks() - deadline) >= 0) has_deadline = 0;
+	GUI_UpdateTimers();
+
+	if (frame_callback) frame_callback(frame_args);
+
+	// skip the frame entirely while nothing on screen changes
+	presented = GUI_IsDirty();
+	if (presented) {
+		__gui_clear_frame();
+		GUI_RenderElements(NULL);
+		SDL_RenderPresent(GUI_GetRenderer());
+	}
+	return !quit;
+}
+
+// run until the window is closed, calling 'on_frame' once per iteration
+void GUI_Run(void (*on_frame)(void *args), void *args) {
+	GUI_SetFrameCallback(on_frame, args);
+	quit = 0;
+	while (GUI_PumpFrame(-1));
+}
@@ -11,10 +11,11 @@
 
 
 void InitElementList(void);
-void load_progress_bar(GUI_ProgressBar *pb);
+void update_frame(void *args);
+void load_progress_bar(void *args);
 
 static Uint8 loading = 0;
-static Uint32 time_now, last_update;
+static GUI_TimerID load_timer = 0;
 
 int main(int argc, char *argv[]) {
 	SDL_Init(SDL_INIT_VIDEO);
@@ -32,38 +33,16 @@ int main(int argc, char *argv[]) {
 
 	GUI_Init(window, renderer); // initialize our library
 	GUI_SetTheme(DARK_MODE); 	// all our library functions use the prefix 'GUI_'
+	GUI_SetRetainedMode(1); 	// repaint only what changed since the last frame
+	GUI_SetAutoCaching(1); 		// keep static elements (buttons, labels...) in textures of their own
+	GUI_SetVSync(1); 			// pace animations by the display's refresh rate (optional)
 
 	// function in elements.c where all elements are defined to minimize clutter (provided by the user, not library)
 	InitElementList();
 
-	int quit = 0;
-	SDL_Event event;
+	// sleeps until the next event or animation step, renders only when something changed
+	GUI_Run(update_frame, NULL);
 
-	while (!quit) {
-		while (SDL_PollEvent(&event)) {
-			if (event.type == SDL_QUIT) quit = 1;
-			GUI_ProcessEvents(&event);
-		}
-		snprintf(buffer1, sizeof(buffer1), "Value: %.0f", slider1->value); 		  // display values of sliders
-		snprintf(buffer2, sizeof(buffer2), "Value: %.1f", slider2->value);
-		snprintf(buffer3, sizeof(buffer3), "Progress: %d%%", progressbar->value); // progress bar percentage
-
-		// clear the screen
-		SDL_SetRenderDrawColor(SDL_GetRenderer(window), bg_color.r, bg_color.g, bg_color.b, bg_color.a);
-		SDL_RenderClear(SDL_GetRenderer(window));
-
-		/* Render existing GUI elements, filter by tag */
-
-		// GUI_RenderButton(button1); 		// render only button1
-		// GUI_RenderElements("button"); 	// render all elements tagged "button"
-		GUI_RenderElements(NULL); 			// render all elements, with and without a tag
-
-		load_progress_bar(progressbar); 	// update progress bar's value (demo-specific function)
-
-		SDL_RenderPresent(SDL_GetRenderer(window));
-
-		SDL_Delay(16); // cap the framerate at approximately 60 FPS (alternative: toggle vsync)
-	}
 	GUI_Quit();
 	SDL_DestroyRenderer(renderer);
 	SDL_DestroyWindow(window);
@@ -72,6 +51,23 @@ int main(int argc, char *argv[]) {
 	return 0;
 }
 
+// called by GUI_Run once per frame, before the elements are rendered
+void update_frame(void *args) {
+	(void)args;
+	snprintf(buffer1, sizeof(buffer1), "Value: %.0f", slider1->value); 		  // display values of sliders
+	snprintf(buffer2, sizeof(buffer2), "Value: %.1f", slider2->value);
+	snprintf(buffer3, sizeof(buffer3), "Progress: %d%%", progressbar->value); // progress bar percentage
+
+	// the library clears behind the elements in retained mode
+	GUI_SetBackgroundColor(bg_color);
+
+	/* Render existing GUI elements, filter by tag */
+
+	// GUI_Run renders all elements when something changed, to draw by hand use GUI_PumpFrame's loop instead:
+	// GUI_RenderButton(button1); 		// render only button1 (immediate mode)
+	// GUI_RenderElements("button"); 	// render all elements tagged "button" (immediate mode)
+}
+
 void button1_click(void *args) {
 	if (!args) return;
 	const char *message = (const char *)args;
@@ -114,26 +110,26 @@ void InitiateLoading(void *args) {
 		if (!loading) {
 			pb->value = pb->min;
 			pb->pos = pb->min;
-			last_update = time_now;
 			loading = 1;
+			// update progress bar's value every 250 milliseconds (demo-specific function)
+			load_timer = GUI_AddTimer(250, 250, load_progress_bar, pb);
 			button4->text = "Loading...";
 			button4->enabled = 0;
 		}
 	}
 }
 
-void load_progress_bar(GUI_ProgressBar *pb) {
-	if (!loading) return;
-	time_now = SDL_GetTicks(); 			// current time, for timed events
-
-	if (time_now - last_update > 250) { // run every 250 milliseconds
-		int inc = rand() % 10; 			// get a random number between 0-9
-		if ((pb->value += inc) >= pb->max) {
-			pb->value = pb->max;
-			button4->text = "Start over!";
-			button4->enabled = 1;
-			loading = 0;
-		}
-		last_update = time_now;
+// timer callback, the scheduler runs it every 250 ms while loading
+void load_progress_bar(void *args) {
+	GUI_ProgressBar *pb = (GUI_ProgressBar*)args;
+
+	int inc = rand() % 10; 				// get a random number between 0-9
+	if ((pb->value += inc) >= pb->max) {
+		pb->value = pb->max;
+		button4->text = "Start over!";
+		button4->enabled = 1;
+		loading = 0;
+		GUI_CancelTimer(load_timer); 	// done, stop repeating
+		load_timer = 0;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,329 @@
+/*
+	Memory pools. Element structs come from fixed-size slabs, one
+	pool per element type, so building a screen costs one malloc per
+	SLAB_OBJECTS elements instead of one per element.
+
+	Pools belong to a screen (GUI_PushScreen). Popping a screen frees
+	its slabs wholesale instead of element by element. Scratch data
+	that is only needed until the next frame comes from the frame
+	arena: a chain of blocks handed out front to back and reset all
+	at once by GUI_RenderElements.
+
+	All of the library's heap memory, pools included, comes from the
+	allocator set with GUI_SetAllocator. Every block carries a small
+	header with its size and category, so GUI_GetMemoryStats knows
+	what is held where without walking anything.
+*/
+
+#include <stdlib.h> // malloc, realloc, free
+#include <stdio.h>  // printf
+#include <string.h> // strlen, memcpy
+#include <stdint.h> // SIZE_MAX
+#include <SDL2/SDL.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define SLAB_OBJECTS 		16 		// elements per slab
+#define ARENA_BLOCK_SIZE 	4096 	// default block size of arenas
+#define FRAME_ARENA_SIZE 	16384 	// initial size of the frame arena
+#define MAX_SCREENS 		16
+#define ALIGNMENT 			16 		// of every pool object and arena allocation
+#define ALIGN(n) 			(((n) + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1))
+
+typedef struct {
+	GUI_Pool pools[GUI_ELEMENT_TYPE_COUNT];
+} GUI_Screen;
+
+static GUI_Screen screens[MAX_SCREENS];
+static int screen_count = 1; 		// the base screen always exists
+static GUI_Arena frame_arena = { NULL, FRAME_ARENA_SIZE, GUI_MEM_SCRATCH };
+
+static const size_t element_sizes[GUI_ELEMENT_TYPE_COUNT] = {
+	[GUI_LABEL] = sizeof(GUI_Label),
+	[GUI_BUTTON] = sizeof(GUI_Button),
+	[GUI_SLIDER] = sizeof(GUI_Slider),
+	[GUI_INPUT] = sizeof(GUI_Input),
+	[GUI_CHECKBOX] = sizeof(GUI_Checkbox),
+	[GUI_RADIOBUTTON] = sizeof(GUI_RadioButton),
+	[GUI_RADIOGROUP] = sizeof(GUI_RadioGroup),
+	[GUI_PROGRESSBAR] = sizeof(GUI_ProgressBar),
+	[GUI_LISTBOX] = sizeof(GUI_ListBox)
+};
+
+/* Allocator hooks and accounting */
+
+// in front of every block: what to subtract when it's freed
+typedef struct {
+	size_t size;
+	GUI_MemoryCategory category;
+} GUI_BlockHeader;
+
+#define HEADER_SIZE 		ALIGN(sizeof(GUI_BlockHeader))
+
+static void *__gui_default_malloc(size_t size, void *userdata) {
+	(void)userdata;
+	return malloc(size);
+}
+
+static void *__gui_default_realloc(void *ptr, size_t size, void *userdata) {
+	(void)userdata;
+	return realloc(ptr, size);
+}
+
+static void __gui_default_free(void *ptr, void *userdata) {
+	(void)userdata;
+	free(ptr);
+}
+
+static GUI_Allocator allocator = { __gui_default_malloc, __gui_default_realloc, __gui_default_free, NULL };
+static GUI_MemoryStats memory_stats = {0};
+static int live_blocks = 0;
+static SDL_SpinLock stats_lock = 0; 	// the text workers allocate too
+
+static void __gui_account(GUI_MemoryCategory category, size_t size, int blocks, int add) {
+	SDL_AtomicLock(&stats_lock);
+	if (add) {
+		memory_stats.bytes[category] += size;
+		memory_stats.total_bytes += size;
+		if (memory_stats.bytes[category] > memory_stats.peak_bytes[category])
+			memory_stats.peak_bytes[category] = memory_stats.bytes[category];
+	} else {
+		memory_stats.bytes[category] -= size;
+		memory_stats.total_bytes -= size;
+	}
+	memory_stats.allocations[category] += add ? blocks : -blocks;
+	live_blocks += add ? blocks : -blocks;
+	SDL_AtomicUnlock(&stats_lock);
+}
+
+void *__gui_malloc(size_t size, GUI_MemoryCategory category) {
+	GUI_BlockHeader *h = allocator.malloc(HEADER_SIZE + size, allocator.userdata);
+	if (!h) return NULL;
+
+	*h = (GUI_BlockHeader){ size, category };
+	__gui_account(category, size, 1, 1);
+	return (char *)h + HEADER_SIZE;
+}
+
+void *__gui_calloc(size_t count, size_t size, GUI_MemoryCategory category) {
+	if (size && count > SIZE_MAX / size) return NULL;
+
+	void *p = __gui_malloc(count * size, category);
+	if (p) SDL_memset(p, 0, count * size);
+	return p;
+}
+
+// keeps the category the block was allocated with
+void *__gui_realloc(void *ptr, size_t size, GUI_MemoryCategory category) {
+	if (!ptr) return __gui_malloc(size, category);
+
+	GUI_BlockHeader *h = (GUI_BlockHeader *)((char *)ptr - HEADER_SIZE);
+	GUI_BlockHeader old = *h;
+
+	h = allocator.realloc(h, HEADER_SIZE + size, allocator.userdata);
+	if (!h) return NULL; 	// the old block is untouched
+
+	h->size = size;
+	__gui_account(old.category, old.size, 0, 0);
+	__gui_account(old.category, size, 0, 1);
+	return (char *)h + HEADER_SIZE;
+}
+
+char *__gui_strdup(const char *text, GUI_MemoryCategory category) {
+	if (!text) return NULL;
+
+	size_t length = strlen(text) + 1;
+	char *copy = __gui_malloc(length, category);
+	if (copy) memcpy(copy, text, length);
+	return copy;
+}
+
+void __gui_free(void *ptr) {
+	if (!ptr) return;
+
+	GUI_BlockHeader *h = (GUI_BlockHeader *)((char *)ptr - HEADER_SIZE);
+	__gui_account(h->category, h->size, 1, 0);
+	allocator.free(h, allocator.userdata);
+}
+
+// add a texture the library created to the stats, or remove it before it's destroyed
+void __gui_count_texture(SDL_Texture *texture, int created) {
+	Uint32 format;
+	int w, h;
+	if (!texture || SDL_QueryTexture(texture, &format, NULL, &w, &h) != 0) return;
+
+	Uint64 bytes = (Uint64)w * h * SDL_BYTESPERPIXEL(format);
+	SDL_AtomicLock(&stats_lock);
+	memory_stats.texture_bytes += created ? bytes : -bytes;
+	memory_stats.textures += created ? 1 : -1;
+	SDL_AtomicUnlock(&stats_lock);
+}
+
+// route the library's memory to another allocator; only possible while it holds none (before GUI_Init)
+int GUI_SetAllocator(const GUI_Allocator *custom) {
+	if (live_blocks > 0) {
+		printf("\n[!] Allocator can't change while %d blocks are allocated, set it before GUI_Init().\n", live_blocks);
+		return 0;
+	}
+	if (custom && (!custom->malloc || !custom->realloc || !custom->free)) {
+		printf("\n[!] Allocator is missing a function.\n");
+		return 0;
+	}
+	allocator = custom ? *custom : (GUI_Allocator){ __gui_default_malloc, __gui_default_realloc, __gui_default_free, NULL };
+	return 1;
+}
+
+// memory the library holds right now, per category (cheap, meant to be polled)
+void GUI_GetMemoryStats(GUI_MemoryStats *stats) {
+	if (!stats) return;
+
+	SDL_AtomicLock(&stats_lock);
+	*stats = memory_stats;
+	SDL_AtomicUnlock(&stats_lock);
+}
+
+/* Arenas */
+
+// zeroed memory valid until the arena is reset or freed
+void *__gui_arena_alloc(GUI_Arena *arena, size_t size) {
+	size = ALIGN(size);
+	GUI_ArenaBlock *block = arena->blocks;
+
+	if (!block || block->used + size > block->size) {
+		size_t block_size = arena->block_size ? arena->block_size : ARENA_BLOCK_SIZE;
+		if (size > block_size) block_size = size;
+
+		block = __gui_malloc(ALIGN(sizeof(GUI_ArenaBlock)) + block_size, arena->category);
+		if (!block) {
+			printf("\n[!] Failed to allocate an arena block of %zu bytes.\n", block_size);
+			return NULL;
+		}
+		*block = (GUI_ArenaBlock){ arena->blocks, 0, block_size };
+		arena->blocks = block;
+	}
+
+	void *p = (char *)block + ALIGN(sizeof(GUI_ArenaBlock)) + block->used;
+	block->used += size;
+	SDL_memset(p, 0, size);
+	return p;
+}
+
+// hand out the memory again from the start; an arena that needed several blocks gets one big enough next time
+void __gui_arena_reset(GUI_Arena *arena) {
+	GUI_ArenaBlock *block = arena->blocks;
+	if (!block) return;
+
+	if (block->next) {
+		size_t total = 0;
+		for (GUI_ArenaBlock *b = block; b; b = b->next) total += b->size;
+		__gui_arena_free(arena);
+		arena->block_size = total;
+		return;
+	}
+	block->used = 0;
+}
+
+void __gui_arena_free(GUI_Arena *arena) {
+	GUI_ArenaBlock *block = arena->blocks;
+	while (block) {
+		GUI_ArenaBlock *next = block->next;
+		__gui_free(block);
+		block = next;
+	}
+	arena->blocks = NULL;
+}
+
+/* Slab pools */
+
+static void *__gui_pool_alloc(GUI_Pool *pool, size_t object_size) {
+	if (!pool->free_list) {
+		pool->object_size = ALIGN(object_size);
+
+		// the slab's first bytes chain it to the previous one, objects follow
+		char *slab = __gui_malloc(ALIGNMENT + pool->object_size * SLAB_OBJECTS, GUI_MEM_ELEMENTS);
+		if (!slab) {
+			printf("\n[!] Failed to allocate a slab of %d elements.\n", SLAB_OBJECTS);
+			return NULL;
+		}
+		*(void **)slab = pool->slabs;
+		pool->slabs = slab;
+
+		for (int i = SLAB_OBJECTS - 1; i >= 0; i--) {
+			void *object = slab + ALIGNMENT + pool->object_size * i;
+			*(void **)object = pool->free_list;
+			pool->free_list = object;
+		}
+	}
+
+	void *object = pool->free_list;
+	pool->free_list = *(void **)object;
+	pool->live++;
+	return object;
+}
+
+static void __gui_pool_free(GUI_Pool *pool, void *object) {
+	*(void **)object = pool->free_list;
+	pool->free_list = object;
+	pool->live--;
+}
+
+static void __gui_pool_release(GUI_Pool *pool) {
+	void *slab = pool->slabs;
+	while (slab) {
+		void *next = *(void **)slab;
+		__gui_free(slab);
+		slab = next;
+	}
+	*pool = (GUI_Pool){0};
+}
+
+/* Elements and screens */
+
+// storage for a new element of the current screen (initialized by the caller)
+void *__gui_alloc_element(GUI_ElementType type) {
+	return __gui_pool_alloc(&screens[screen_count - 1].pools[type], element_sizes[type]);
+}
+
+// give a deleted element's storage back to the screen it was created on
+void __gui_free_element(GUI_ElementType type, int screen, void *elem) {
+	if (elem && screen >= 0 && screen < screen_count) __gui_pool_free(&screens[screen].pools[type], elem);
+}
+
+// scratch memory valid until the next frame
+void *__gui_frame_alloc(size_t size) {
+	return __gui_arena_alloc(&frame_arena, size);
+}
+
+void __gui_frame_reset() {
+	__gui_arena_reset(&frame_arena);
+}
+
+int __gui_current_screen() {
+	return screen_count - 1;
+}
+
+// start a screen on top of the current one; returns its index, -1 if too many are open
+int __gui_screen_push() {
+	if (screen_count == MAX_SCREENS) {
+		printf("\n[!] Too many screens (max %d).\n", MAX_SCREENS);
+		return -1;
+	}
+	screens[screen_count] = (GUI_Screen){0};
+	return screen_count++;
+}
+
+// free the top screen's memory in one go (its elements must be unregistered already)
+void __gui_screen_release() {
+	GUI_Screen *screen = &screens[screen_count - 1];
+	for (int t = 0; t < GUI_ELEMENT_TYPE_COUNT; t++) __gui_pool_release(&screen->pools[t]);
+
+	if (screen_count > 1) screen_count--;
+}
+
+// release every screen and the frame arena (GUI_Quit)
+void __gui_memory_quit() {
+	while (screen_count > 1) __gui_screen_release();
+	__gui_screen_release(); 	// the base screen stays, empty
+	__gui_arena_free(&frame_arena);
+	frame_arena.block_size = FRAME_ARENA_SIZE;
+}
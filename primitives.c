@@ -0,0 +1,333 @@
+/*
+	Anti-aliased primitives: lines, filled circles, rings and
+	rounded rectangles. Shapes are tessellated into triangle
+	meshes with a one pixel wide fringe that fades out to
+	transparent, which gives smooth edges without per-pixel
+	work on the CPU.
+
+	Meshes are built relative to their origin and cached by
+	shape, so drawing the same checkmark or radio button again
+	only moves it; they go through the command list (batch.c)
+	together with the colored quads.
+*/
+
+#include <SDL2/SDL.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define MESH_CACHE_SIZE 	256 	// cached shapes (power of two)
+#define MIN_SEGMENTS 		12 		// segments of a full circle
+#define MAX_SEGMENTS 		96
+#define QUANTIZE 			4 		// shape parameters are cached in quarter pixels
+
+typedef enum {
+	MESH_LINE,
+	MESH_CIRCLE,
+	MESH_RING,
+	MESH_ROUNDED_RECT,
+	MESH_ROUNDED_RING
+} GUI_MeshKind;
+
+typedef struct {
+	int kind, a, b, c, d; 	// quantized shape parameters
+} GUI_MeshKey;
+
+typedef struct {
+	GUI_MeshKey key;
+	GUI_Mesh *mesh; 		// NULL: empty slot
+} GUI_MeshEntry;
+
+static GUI_MeshEntry mesh_cache[MESH_CACHE_SIZE];
+static int mesh_count = 0;
+
+// contour of a convex shape: points on the outline and the offset that moves a point one pixel outwards
+static SDL_FPoint *contour = NULL, *offsets = NULL;
+static int contour_cap = 0;
+
+static GUI_Mesh *__gui_mesh_alloc(int vertex_count, int index_count) {
+	GUI_Mesh *m = __gui_malloc(sizeof(GUI_Mesh) + sizeof(SDL_Vertex) * vertex_count + sizeof(int) * index_count, GUI_MEM_RENDER);
+	if (!m) return NULL;
+
+	m->vertices = (SDL_Vertex *)(m + 1);
+	m->indices = (int *)(m->vertices + vertex_count);
+	m->vertex_count = 0;
+	m->index_count = 0;
+	return m;
+}
+
+// vertex color is white, alpha holds the coverage (tinted when the mesh is drawn)
+static int __gui_mesh_vertex(GUI_Mesh *m, float x, float y, float coverage) {
+	m->vertices[m->vertex_count] = (SDL_Vertex){ { x, y }, { 255, 255, 255, (Uint8)(coverage * 255 + 0.5f) }, { 0, 0 } };
+	return m->vertex_count++;
+}
+
+static void __gui_mesh_quad(GUI_Mesh *m, int a, int b, int c, int d) {
+	int *i = &m->indices[m->index_count];
+	i[0] = a; i[1] = b; i[2] = c;
+	i[3] = a; i[4] = c; i[5] = d;
+	m->index_count += 6;
+}
+
+static void __gui_mesh_bounds(GUI_Mesh *m) {
+	float x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+	for (int i = 0; i < m->vertex_count; i++) {
+		SDL_FPoint p = m->vertices[i].position;
+		if (i == 0 || p.x < x0) x0 = p.x;
+		if (i == 0 || p.y < y0) y0 = p.y;
+		if (i == 0 || p.x > x1) x1 = p.x;
+		if (i == 0 || p.y > y1) y1 = p.y;
+	}
+	int x = (int)SDL_floorf(x0), y = (int)SDL_floorf(y0);
+	m->bounds = (SDL_Rect){ x, y, (int)SDL_ceilf(x1) - x, (int)SDL_ceilf(y1) - y };
+}
+
+/* Contours */
+
+static int __gui_reserve_contour(int count) {
+	if (count <= contour_cap) return 1;
+
+	SDL_FPoint *p = __gui_realloc(contour, sizeof(SDL_FPoint) * count, GUI_MEM_RENDER);
+	if (!p) return 0;
+	contour = p;
+
+	SDL_FPoint *o = __gui_realloc(offsets, sizeof(SDL_FPoint) * count, GUI_MEM_RENDER);
+	if (!o) return 0;
+	offsets = o;
+
+	contour_cap = count;
+	return 1;
+}
+
+static int __gui_segments(float radius, float angle) {
+	int full = SDL_clamp((int)(radius * 2) + 8, MIN_SEGMENTS, MAX_SEGMENTS);
+	int n = (int)SDL_ceilf(full * angle / (2 * (float)M_PI));
+	return n < 1 ? 1 : n;
+}
+
+// circle around (0, 0), returns the point count
+static int __gui_circle_contour(float radius) {
+	int n = __gui_segments(radius, 2 * (float)M_PI);
+	if (!__gui_reserve_contour(n)) return 0;
+
+	for (int i = 0; i < n; i++) {
+		float a = 2 * (float)M_PI * i / n;
+		offsets[i] = (SDL_FPoint){ SDL_cosf(a), SDL_sinf(a) };
+		contour[i] = (SDL_FPoint){ offsets[i].x * radius, offsets[i].y * radius };
+	}
+	return n;
+}
+
+// rectangle at (0, 0) with quarter circles of 'radius' as corners (0: square corners)
+static int __gui_rounded_contour(float w, float h, float radius) {
+	radius = SDL_clamp(radius, 0, SDL_min(w, h) / 2);
+	int per_corner = radius > 0 ? __gui_segments(radius, (float)M_PI / 2) + 1 : 1;
+	if (!__gui_reserve_contour(per_corner * 4)) return 0;
+
+	// corner centers clockwise from the top-left, each corner sweeps a quarter turn
+	SDL_FPoint centers[4] = { { radius, radius }, { w - radius, radius }, { w - radius, h - radius }, { radius, h - radius } };
+	int n = 0;
+
+	for (int c = 0; c < 4; c++) {
+		for (int i = 0; i < per_corner; i++) {
+			if (radius > 0) {
+				float a = (float)M_PI * (1 + c * 0.5f) + (float)M_PI / 2 * i / (per_corner - 1);
+				offsets[n] = (SDL_FPoint){ SDL_cosf(a), SDL_sinf(a) };
+			} else {
+				// square corner: one pixel out along both edges
+				offsets[n] = (SDL_FPoint){ c == 0 || c == 3 ? -1.0f : 1.0f, c < 2 ? -1.0f : 1.0f };
+			}
+			contour[n] = (SDL_FPoint){ centers[c].x + offsets[n].x * radius, centers[c].y + offsets[n].y * radius };
+			n++;
+		}
+	}
+	return n;
+}
+
+// fill the contour, its edge fades out over one pixel
+static GUI_Mesh *__gui_fill_contour(int n, SDL_FPoint center) {
+	if (n < 3) return NULL;
+
+	GUI_Mesh *m = __gui_mesh_alloc(1 + n * 2, n * 3 + n * 6);
+	if (!m) return NULL;
+
+	int c = __gui_mesh_vertex(m, center.x, center.y, 1);
+	for (int i = 0; i < n; i++) {
+		__gui_mesh_vertex(m, contour[i].x - offsets[i].x * 0.5f, contour[i].y - offsets[i].y * 0.5f, 1);
+		__gui_mesh_vertex(m, contour[i].x + offsets[i].x * 0.5f, contour[i].y + offsets[i].y * 0.5f, 0);
+	}
+	for (int i = 0; i < n; i++) {
+		int in = 1 + i * 2, next = 1 + (i + 1) % n * 2;
+		m->indices[m->index_count++] = c;
+		m->indices[m->index_count++] = in;
+		m->indices[m->index_count++] = next;
+		__gui_mesh_quad(m, in, in + 1, next + 1, next);
+	}
+	return m;
+}
+
+// stroke along the contour, 'inner_limit' keeps the inside from folding over (circles)
+static GUI_Mesh *__gui_stroke_contour(int n, float thickness, float inner_limit) {
+	if (n < 3) return NULL;
+
+	// strokes thinner than a pixel keep a pixel wide core and fade instead
+	float half = SDL_max(thickness, 1) / 2;
+	float coverage = SDL_min(thickness, 1);
+	float steps[4] = { -half - 0.5f, -half + 0.5f, half - 0.5f, half + 0.5f };
+	float alpha[4] = { 0, coverage, coverage, 0 };
+	for (int s = 0; s < 4; s++)
+		if (steps[s] < -inner_limit) steps[s] = -inner_limit;
+
+	GUI_Mesh *m = __gui_mesh_alloc(n * 4, n * 18);
+	if (!m) return NULL;
+
+	for (int i = 0; i < n; i++)
+		for (int s = 0; s < 4; s++)
+			__gui_mesh_vertex(m, contour[i].x + offsets[i].x * steps[s], contour[i].y + offsets[i].y * steps[s], alpha[s]);
+
+	for (int i = 0; i < n; i++) {
+		int a = i * 4, b = (i + 1) % n * 4;
+		for (int s = 0; s < 3; s++)
+			__gui_mesh_quad(m, a + s, a + s + 1, b + s + 1, b + s);
+	}
+	return m;
+}
+
+/* Shapes */
+
+static GUI_Mesh *__gui_build_line(float dx, float dy, float thickness) {
+	float length = SDL_sqrtf(dx * dx + dy * dy);
+	if (length <= 0) return NULL;
+
+	// along the line, and one pixel across it
+	float ux = dx / length, uy = dy / length;
+	float nx = -uy, ny = ux;
+
+	float half = SDL_max(thickness, 1) / 2;
+	float coverage = SDL_min(thickness, 1);
+	float steps[4] = { -half - 0.5f, -half + 0.5f, half - 0.5f, half + 0.5f };
+	float alpha[4] = { 0, coverage, coverage, 0 };
+
+	GUI_Mesh *m = __gui_mesh_alloc(8, 18);
+	if (!m) return NULL;
+
+	// ends are extended by half a pixel to match the coverage of the end pixels
+	for (int end = 0; end < 2; end++) {
+		float x = end ? dx + ux * 0.5f : -ux * 0.5f;
+		float y = end ? dy + uy * 0.5f : -uy * 0.5f;
+		for (int s = 0; s < 4; s++)
+			__gui_mesh_vertex(m, x + nx * steps[s], y + ny * steps[s], alpha[s]);
+	}
+	for (int s = 0; s < 3; s++)
+		__gui_mesh_quad(m, s, s + 1, 4 + s + 1, 4 + s);
+	return m;
+}
+
+static GUI_Mesh *__gui_build_mesh(const GUI_MeshKey *key) {
+	float a = (float)key->a / QUANTIZE, b = (float)key->b / QUANTIZE;
+	float c = (float)key->c / QUANTIZE, d = (float)key->d / QUANTIZE;
+
+	switch (key->kind) {
+	case MESH_LINE:
+		return __gui_build_line(a, b, c);
+	case MESH_CIRCLE:
+		return __gui_fill_contour(__gui_circle_contour(a), (SDL_FPoint){ 0, 0 });
+	case MESH_RING:
+		return __gui_stroke_contour(__gui_circle_contour(a), b, a);
+	case MESH_ROUNDED_RECT:
+		return __gui_fill_contour(__gui_rounded_contour(a, b, c), (SDL_FPoint){ a / 2, b / 2 });
+	case MESH_ROUNDED_RING:
+		return __gui_stroke_contour(__gui_rounded_contour(a, b, c), d, SDL_min(a, b) / 2);
+	}
+	return NULL;
+}
+
+/* Mesh cache */
+
+static void __gui_mesh_cache_clear() {
+	__gui_batch_flush(); 	// recorded commands refer to the meshes
+	for (int i = 0; i < MESH_CACHE_SIZE; i++) {
+		__gui_free(mesh_cache[i].mesh);
+		mesh_cache[i].mesh = NULL;
+	}
+	mesh_count = 0;
+}
+
+static int __gui_quantize(float value) {
+	return (int)SDL_floorf(value * QUANTIZE + 0.5f);
+}
+
+// mesh of a shape, built on first use
+static const GUI_Mesh *__gui_get_mesh(GUI_MeshKind kind, float a, float b, float c, float d) {
+	GUI_MeshKey key = { kind, __gui_quantize(a), __gui_quantize(b), __gui_quantize(c), __gui_quantize(d) };
+	Uint32 hash = __gui_hash_bytes(GUI_HASH_INIT, &key, sizeof(key));
+
+	for (int i = 0; i < MESH_CACHE_SIZE; i++) {
+		GUI_MeshEntry *e = &mesh_cache[(hash + i) & (MESH_CACHE_SIZE - 1)];
+		if (!e->mesh) break;
+		if (SDL_memcmp(&e->key, &key, sizeof(key)) == 0) return e->mesh;
+	}
+
+	// keep the table at most three quarters full, shapes in use are rebuilt on their next draw
+	if (mesh_count >= MESH_CACHE_SIZE * 3 / 4) __gui_mesh_cache_clear();
+
+	GUI_Mesh *m = __gui_build_mesh(&key);
+	if (!m) return NULL;
+	__gui_mesh_bounds(m);
+
+	for (int i = 0; i < MESH_CACHE_SIZE; i++) {
+		GUI_MeshEntry *e = &mesh_cache[(hash + i) & (MESH_CACHE_SIZE - 1)];
+		if (!e->mesh) {
+			*e = (GUI_MeshEntry){ key, m };
+			mesh_count++;
+			return m;
+		}
+	}
+	__gui_free(m);
+	return NULL;
+}
+
+/* Drawing (current color, see __gui_set_color) */
+
+// one pixel wide anti-aliased line between two pixels
+void __gui_draw_line(int x1, int y1, int x2, int y2) {
+	const GUI_Mesh *m = __gui_get_mesh(MESH_LINE, (float)(x2 - x1), (float)(y2 - y1), 1, 0);
+	if (m) __gui_batch_mesh(m, x1 + 0.5f, y1 + 0.5f); 	// through the pixel centers
+}
+
+void __gui_fill_circle(float cx, float cy, float radius) {
+	if (radius <= 0) return;
+	const GUI_Mesh *m = __gui_get_mesh(MESH_CIRCLE, radius, 0, 0, 0);
+	if (m) __gui_batch_mesh(m, cx, cy);
+}
+
+// circle outline centered on 'radius'
+void __gui_draw_circle(float cx, float cy, float radius, float thickness) {
+	if (radius <= 0 || thickness <= 0) return;
+	const GUI_Mesh *m = __gui_get_mesh(MESH_RING, radius, thickness, 0, 0);
+	if (m) __gui_batch_mesh(m, cx, cy);
+}
+
+void __gui_fill_rounded_rect(const SDL_Rect *rect, int radius) {
+	if (!rect || rect->w <= 0 || rect->h <= 0) return;
+	const GUI_Mesh *m = __gui_get_mesh(MESH_ROUNDED_RECT, (float)rect->w, (float)rect->h, (float)radius, 0);
+	if (m) __gui_batch_mesh(m, (float)rect->x, (float)rect->y);
+}
+
+// border of 'thickness' around the outside of a rounded rectangle
+void __gui_draw_rounded_border(const SDL_Rect *rect, int radius, int thickness) {
+	if (!rect || thickness <= 0) return;
+
+	// the stroke is centered on its contour, move the contour out by half the thickness
+	float half = thickness / 2.0f;
+	const GUI_Mesh *m = __gui_get_mesh(MESH_ROUNDED_RING, rect->w + thickness, rect->h + thickness, radius + half, (float)thickness);
+	if (m) __gui_batch_mesh(m, rect->x - half, rect->y - half);
+}
+
+// free every cached mesh (GUI_Quit)
+void __gui_primitives_quit() {
+	__gui_mesh_cache_clear();
+	__gui_free(contour);
+	__gui_free(offsets);
+	contour = offsets = NULL;
+	contour_cap = 0;
+}
@@ -1,12 +1,11 @@
 #include <SDL2/SDL.h>
-#include <stdlib.h> // malloc
 #include <stdio.h>  // printf
 #include "guilib.h"
 #include "defs.h"
 
 #define BAR_HEIGHT 			22
 #define BORDER_WIDTH 		1
-#define SMOOTHING_SPEED 	0.1f // linear interpolation speed for drawing the filled portion
+#define SMOOTHING_MS 		300 	// time the filled portion takes to catch up with a new value
 
 
 GUI_ProgressBar *GUI_CreateProgressBar(int x, int y, int width, int min, int max) {
@@ -14,7 +13,8 @@ GUI_ProgressBar *GUI_CreateProgressBar(int x, int y, int width, int min, int max
 		printf("\n[!] Invalid progress bar range: min (%d) must be less than max (%d). Aborted.\n", min, max);
 		return NULL;
 	}
-	GUI_ProgressBar *pb = malloc(sizeof(GUI_ProgressBar));
+	GUI_ProgressBar *pb = __gui_alloc_element(GUI_PROGRESSBAR);
+	if (!pb) return NULL;
 
 	*pb = (GUI_ProgressBar){
 		.tag = NULL,
@@ -27,7 +27,9 @@ GUI_ProgressBar *GUI_CreateProgressBar(int x, int y, int width, int min, int max
 		.min = min,
 		.max = max,
 		.value = 0,
-		.pos = 0
+		.pos = 0,
+		.target = 0,
+		.tween = 0
 	};
 
 	// add to general list of elements for simplified processing
@@ -35,29 +37,43 @@ GUI_ProgressBar *GUI_CreateProgressBar(int x, int y, int width, int min, int max
 	return pb;
 }
 
-void GUI_RenderProgressBar(GUI_ProgressBar *bar) {
-	if (!bar || !bar->visible) return; // NULL pointer or hidden element
+// width of the filled portion at a given (smoothed) value
+int __gui_progress_fill(GUI_ProgressBar *bar, float pos) {
+	if (bar->max <= bar->min) return 0;
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
+	float ratio = (float)(pos - bar->min) / (bar->max - bar->min);
 
-	__gui_draw_borders(bar->x, bar->y, bar->width, bar->height, bar->border_width);
+	int filled_width = (int)(ratio * bar->width);
+	if (pos > (bar->max - 1)) filled_width = bar->width; // fix rounding errors (99.999... = 100)
+	// if (bar->value == bar->max) filled_width = bar->width; // instantly snap to end when finished
+	return filled_width;
+}
 
-	// render empty base bar
-	SDL_SetRenderDrawColor(renderer, SET_COLOR_INPUT_ACTIVE);
-	SDL_Rect bar_rect = { bar->x, bar->y, bar->width, bar->height };
-	SDL_RenderFillRect(renderer, &bar_rect);
+// ease the drawn position towards a new value (also evaluated before rendering to detect changes)
+void __gui_progress_update(GUI_ProgressBar *bar) {
+	if (bar->value == bar->target) return;
 
-	// interpolate lerped value towards real value
-	bar->pos += (bar->value - bar->pos) * SMOOTHING_SPEED;
+	bar->target = bar->value;
+	bar->tween = GUI_AddTween(&bar->pos, (float)bar->value, SMOOTHING_MS, GUI_EASE_OUT);
+}
 
-	float ratio = (float)(bar->pos - bar->min) / (bar->max - bar->min);
+void GUI_RenderProgressBar(GUI_ProgressBar *bar) {
+	if (!bar || !bar->visible) return; // NULL pointer or hidden element
 
-	int filled_width = (int)(ratio * bar->width);
-	if (bar->pos > (bar->max - 1)) filled_width = bar->width; // fix rounding errors (99.999... = 100)
-	// if (bar->value == bar->max) filled_width = bar->width; // instantly snap to end when finished
+	__gui_draw_borders(bar->x, bar->y, bar->width, bar->height, bar->border_width);
+
+	// the scheduler moves the smoothed value towards the real one over time
+	__gui_progress_update(bar);
+
+	int filled_width = __gui_progress_fill(bar, bar->pos);
 
 	// render bar's filled portion
-	SDL_SetRenderDrawColor(renderer, SET_COLOR_PROGRESS);
+	__gui_set_color(SET_COLOR_PROGRESS);
 	SDL_Rect filled_rect = { bar->x, bar->y, filled_width, bar->height };
-	SDL_RenderFillRect(renderer, &filled_rect);
+	__gui_fill_rect(&filled_rect);
+
+	// render the empty rest of the bar next to it
+	__gui_set_color(SET_COLOR_INPUT_ACTIVE);
+	SDL_Rect empty_rect = { bar->x + filled_width, bar->y, bar->width - filled_width, bar->height };
+	__gui_fill_rect(&empty_rect);
 }
\ No newline at end of file
@@ -1,5 +1,3 @@
-#include <stdlib.h> // malloc
-#include <SDL2/SDL2_gfxPrimitives.h>
 #include "guilib.h"
 #include "defs.h"
 
@@ -11,7 +9,8 @@
 static void __gui_process_radiobutton(SDL_Event *event, GUI_RadioButton *radiobutton, int mx, int my);
 
 GUI_RadioButton *GUI_CreateRadioButton(int x, int y) {
-	GUI_RadioButton *rb = malloc(sizeof(GUI_RadioButton));
+	GUI_RadioButton *rb = __gui_alloc_element(GUI_RADIOBUTTON);
+	if (!rb) return NULL;
     *rb = (GUI_RadioButton){
 		.tag = NULL,
 		.x = x,
@@ -33,8 +32,9 @@ GUI_RadioButton *GUI_CreateRadioButton(int x, int y) {
 
 GUI_RadioGroup *GUI_CreateRadioGroup() {
 	// group radio buttons together to allow selecting only one
-	GUI_RadioGroup *rg = malloc(sizeof(GUI_RadioGroup));
-    *rg = (GUI_RadioGroup){ NULL, 0 };
+	GUI_RadioGroup *rg = __gui_alloc_element(GUI_RADIOGROUP);
+	if (!rg) return NULL;
+    *rg = (GUI_RadioGroup){ NULL, 0, 0 };
 
 	__gui_add_element(GUI_RADIOGROUP, rg, NULL, NULL);
 	return rg;
@@ -43,32 +43,42 @@ GUI_RadioGroup *GUI_CreateRadioGroup() {
 void GUI_RenderRadioButton(GUI_RadioButton *radiobutton) {
 	if (!radiobutton || !radiobutton->visible) return; // NULL pointer hidden element
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
 	int center_x = radiobutton->x + radiobutton->r; 	// find center point for drawing
 	int center_y = radiobutton->y + radiobutton->r - 2; // make button more or less aligned with checkboxes
 
-	// render the radio button (SDL2_gfx)
+	// render the radio button
 	if (!radiobutton->enabled)
-		filledCircleRGBA(renderer, center_x, center_y, radiobutton->r, SET_COLOR_DISABLED);
+		__gui_set_color(SET_COLOR_DISABLED);
 	else if (radiobutton->focus)
-		filledCircleRGBA(renderer, center_x, center_y, radiobutton->r, SET_COLOR_FOCUS);
+		__gui_set_color(SET_COLOR_FOCUS);
 	else
-		filledCircleRGBA(renderer, center_x, center_y, radiobutton->r, SET_COLOR_NORMAL);
+		__gui_set_color(SET_COLOR_NORMAL);
+	__gui_draw_sprite(GUI_SPRITE_DISC, radiobutton->r, center_x, center_y); 	// (sprites.c)
 
-	// due to a lack of anti-aliased filled circle, the borders must be drawn after the button
-	if (radiobutton->border_width > 0)
-		aacircleRGBA(renderer, center_x, center_y, radiobutton->r, SET_COLOR_BORDER); // SDL2_gfx
+	// one pixel wide ring on the button's edge
+	if (radiobutton->border_width > 0) {
+		__gui_set_color(SET_COLOR_BORDER);
+		__gui_draw_sprite(GUI_SPRITE_RING, radiobutton->r, center_x, center_y);
+	}
 
-	// render the bullet (SDL2_gfx)
+	// render the bullet
 	if (radiobutton->selected) {
-		filledCircleRGBA(renderer, center_x, center_y, radiobutton->bullet_r, SET_COLOR_TEXT_ENABLED);
-		aacircleRGBA(renderer, center_x, center_y, radiobutton->bullet_r, SET_COLOR_TEXT_PLACEHOLDER);
+		__gui_set_color(SET_COLOR_TEXT_ENABLED);
+		__gui_draw_sprite(GUI_SPRITE_DISC, radiobutton->bullet_r, center_x, center_y);
+		__gui_set_color(SET_COLOR_TEXT_PLACEHOLDER);
+		__gui_draw_sprite(GUI_SPRITE_RING, radiobutton->bullet_r, center_x, center_y);
 	}
 }
 
 void GUI_AddToRadioGroup(GUI_RadioGroup *group, GUI_RadioButton *radiobutton) {
-	group->buttons = realloc(group->buttons, sizeof(GUI_RadioButton*) * (group->button_count + 1));
+	// grow by doubling, groups are usually filled one button at a time
+	if (group->button_count == group->button_cap) {
+		int cap = group->button_cap ? group->button_cap * 2 : 4;
+		GUI_RadioButton **buttons = __gui_realloc(group->buttons, sizeof(GUI_RadioButton*) * cap, GUI_MEM_ELEMENTS);
+		if (!buttons) return;
+		group->buttons = buttons;
+		group->button_cap = cap;
+	}
 	group->buttons[group->button_count++] = radiobutton;
 	radiobutton->group = group;
 }
@@ -0,0 +1,340 @@
+/*
+	Scheduler. One-shot and periodic timers and time-based tweens,
+	evaluated against SDL's monotonic millisecond clock so nothing
+	depends on the frame rate.
+
+	Timers sit on a hierarchical timer wheel: 4 levels of 64 slots
+	with 1 ms, 64 ms, 4 s and 4.4 min granularity (about 4.6 hours
+	in total, later timers wait in the last level). A timer goes to
+	the finest level whose range covers it and moves down a level
+	each time its slot comes up, so adding, cancelling and firing
+	are constant time. Stretches of ticks without timers are skipped
+	in one step, a loop that slept for an hour catches up at once.
+
+	Tweens move a float towards a target over a duration and are
+	updated on every GUI_UpdateTimers; while one runs the next
+	deadline is the next frame.
+*/
+
+#include <stdio.h>  // printf
+#include <SDL2/SDL.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define WHEEL_LEVELS 		4
+#define WHEEL_BITS 			6
+#define WHEEL_SLOTS 		(1 << WHEEL_BITS)
+#define WHEEL_MASK 			(WHEEL_SLOTS - 1)
+#define WHEEL_SPAN 			((Uint64)1 << (WHEEL_BITS * WHEEL_LEVELS)) 	// ms covered by all levels
+#define MAX_TIMERS 			256
+
+// lists a timer can be linked into: the wheel's slots, timers being run and running tweens
+#define LIST_DUE 			(WHEEL_LEVELS * WHEEL_SLOTS)
+#define LIST_TWEENS 		(LIST_DUE + 1)
+#define LIST_COUNT 			(LIST_TWEENS + 1)
+#define NONE 				-1
+
+typedef struct {
+	Uint16 generation; 			// part of the id, bumped on reuse so stale ids don't match
+	int list, 					// list the timer is linked into (NONE: unused)
+		prev, next;
+	Uint64 expires; 			// tick the timer fires on
+	Uint32 interval; 			// period of repeating timers (0: one-shot)
+	GUI_TimerCallback callback;
+	void *args;
+
+	// tweens
+	float *value, from, to;
+	Uint64 start;
+	Uint32 duration;
+	GUI_Easing easing;
+} GUI_Timer;
+
+static GUI_Timer timers[MAX_TIMERS];
+static int heads[LIST_COUNT];
+static int level_counts[WHEEL_LEVELS]; 	// timers per level, empty levels are skipped
+static int free_timers = NONE; 			// unused timers, chained through 'next'
+static int initialized = 0;
+static Uint64 wheel_time = 0; 			// last tick processed
+
+static void __gui_scheduler_init() {
+	for (int i = 0; i < LIST_COUNT; i++) heads[i] = NONE;
+	for (int i = 0; i < WHEEL_LEVELS; i++) level_counts[i] = 0;
+
+	free_timers = NONE;
+	for (int i = MAX_TIMERS - 1; i >= 0; i--) {
+		timers[i].list = NONE;
+		timers[i].next = free_timers;
+		free_timers = i;
+	}
+	wheel_time = SDL_GetTicks64();
+	initialized = 1;
+}
+
+/* Lists */
+
+static void __gui_timer_link(int i, int list) {
+	GUI_Timer *t = &timers[i];
+	t->list = list;
+	t->prev = NONE;
+	t->next = heads[list];
+	if (heads[list] != NONE) timers[heads[list]].prev = i;
+	heads[list] = i;
+	if (list < LIST_DUE) level_counts[list / WHEEL_SLOTS]++;
+}
+
+static void __gui_timer_unlink(int i) {
+	GUI_Timer *t = &timers[i];
+	if (t->prev != NONE) timers[t->prev].next = t->next;
+	else heads[t->list] = t->next;
+	if (t->next != NONE) timers[t->next].prev = t->prev;
+	if (t->list < LIST_DUE) level_counts[t->list / WHEEL_SLOTS]--;
+	t->list = NONE;
+}
+
+// put a timer into the slot of the finest level that reaches its expiry
+static void __gui_timer_place(int i) {
+	GUI_Timer *t = &timers[i];
+	if (t->expires <= wheel_time) t->expires = wheel_time + 1; 	// overdue: the next tick
+
+	Uint64 delta = t->expires - wheel_time, slot_time = t->expires;
+	if (delta >= WHEEL_SPAN) slot_time = wheel_time + WHEEL_SPAN - 1; 	// beyond the wheel, comes back around
+
+	int level = 0;
+	while (level < WHEEL_LEVELS - 1 && delta >= ((Uint64)1 << (WHEEL_BITS * (level + 1)))) level++;
+
+	int slot = (int)((slot_time >> (WHEEL_BITS * level)) & WHEEL_MASK);
+	__gui_timer_link(i, level * WHEEL_SLOTS + slot);
+}
+
+/* Timer pool */
+
+static int __gui_timer_alloc() {
+	if (!initialized) __gui_scheduler_init();
+	if (free_timers == NONE) {
+		printf("\n[!] Too many timers (max %d).\n", MAX_TIMERS);
+		return NONE;
+	}
+	int i = free_timers;
+	free_timers = timers[i].next;
+
+	Uint16 generation = timers[i].generation + 1;
+	if (generation == 0) generation = 1; 	// ids are never 0
+	timers[i] = (GUI_Timer){ .generation = generation, .list = NONE, .prev = NONE, .next = NONE };
+	return i;
+}
+
+static void __gui_timer_free(int i) {
+	if (timers[i].list != NONE) __gui_timer_unlink(i);
+	timers[i].next = free_timers;
+	free_timers = i;
+}
+
+static GUI_TimerID __gui_timer_id(int i) {
+	return ((GUI_TimerID)timers[i].generation << 16) | (GUI_TimerID)i;
+}
+
+// index of a live timer, NONE if it has fired, was cancelled or the id is invalid
+static int __gui_timer_index(GUI_TimerID id) {
+	int i = (int)(id & 0xFFFF);
+	if (!id || !initialized || i >= MAX_TIMERS) return NONE;
+	if (timers[i].generation != (Uint16)(id >> 16) || timers[i].list == NONE) return NONE;
+	return i;
+}
+
+/* Wheel */
+
+// process one tick: bring timers down from coarser levels, then run the ones due
+static void __gui_wheel_tick(Uint64 now) {
+	Uint64 tick = wheel_time;
+
+	for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		if (tick & (((Uint64)1 << (WHEEL_BITS * level)) - 1)) continue; 	// not this level's turn
+
+		int list = level * WHEEL_SLOTS + (int)((tick >> (WHEEL_BITS * level)) & WHEEL_MASK);
+		while (heads[list] != NONE) {
+			int i = heads[list];
+			__gui_timer_unlink(i);
+			if (timers[i].expires <= tick) __gui_timer_link(i, LIST_DUE); 	// due on this very boundary
+			else __gui_timer_place(i);
+		}
+	}
+
+	// everything in the current slot of the finest level expires now
+	int list = (int)(tick & WHEEL_MASK);
+	while (heads[list] != NONE) {
+		int i = heads[list];
+		__gui_timer_unlink(i);
+		__gui_timer_link(i, LIST_DUE);
+	}
+
+	// callbacks may add or cancel timers, including the ones still due
+	while (heads[LIST_DUE] != NONE) {
+		int i = heads[LIST_DUE];
+		GUI_Timer *t = &timers[i];
+		GUI_TimerCallback callback = t->callback;
+		void *args = t->args;
+
+		__gui_timer_unlink(i);
+		if (t->interval) {
+			t->expires += t->interval;
+			if (t->expires <= now) t->expires = now + t->interval; 	// missed periods are dropped, not run in a burst
+			__gui_timer_place(i);
+		} else {
+			__gui_timer_free(i);
+		}
+		if (callback) callback(args);
+	}
+}
+
+static void __gui_wheel_advance(Uint64 now) {
+	while (wheel_time < now) {
+		// nothing can fire before the next boundary of the finest occupied level
+		int level = 0;
+		while (level < WHEEL_LEVELS && level_counts[level] == 0) level++;
+		if (level == WHEEL_LEVELS) {
+			wheel_time = now;
+			break;
+		}
+		Uint64 boundary = (wheel_time | (((Uint64)1 << (WHEEL_BITS * level)) - 1)) + 1;
+		if (boundary > now) {
+			wheel_time = now;
+			break;
+		}
+		wheel_time = boundary;
+		__gui_wheel_tick(now);
+	}
+}
+
+/* Tweens */
+
+static float __gui_ease(GUI_Easing easing, float t) {
+	switch (easing) {
+	case GUI_EASE_OUT: 		// decelerating (cubic)
+		t = 1 - t;
+		return 1 - t * t * t;
+	case GUI_EASE_IN_OUT: 	// smoothstep
+		return t * t * (3 - 2 * t);
+	default:
+		return t;
+	}
+}
+
+static void __gui_tweens_update(Uint64 now) {
+	int i = heads[LIST_TWEENS];
+	while (i != NONE) {
+		GUI_Timer *t = &timers[i];
+		int next = t->next;
+
+		float progress = t->duration ? (float)(now - t->start) / t->duration : 1;
+		if (progress >= 1) {
+			*t->value = t->to;
+			__gui_timer_free(i);
+		} else {
+			*t->value = t->from + (t->to - t->from) * __gui_ease(t->easing, progress);
+		}
+		i = next;
+	}
+}
+
+/* Public functions */
+
+// call 'callback' after 'delay_ms', then every 'interval_ms' (0: once); returns 0 on failure
+GUI_TimerID GUI_AddTimer(Uint32 delay_ms, Uint32 interval_ms, GUI_TimerCallback callback, void *args) {
+	int i = __gui_timer_alloc();
+	if (i == NONE) return 0;
+
+	GUI_Timer *t = &timers[i];
+	t->expires = SDL_GetTicks64() + delay_ms;
+	t->interval = interval_ms;
+	t->callback = callback;
+	t->args = args;
+	__gui_timer_place(i);
+	return __gui_timer_id(i);
+}
+
+// move '*value' to 'target' over 'duration_ms', replacing a tween already running on it
+GUI_TimerID GUI_AddTween(float *value, float target, Uint32 duration_ms, GUI_Easing easing) {
+	if (!value) return 0;
+
+	if (initialized) {
+		for (int i = heads[LIST_TWEENS]; i != NONE; i = timers[i].next) {
+			if (timers[i].value == value) {
+				__gui_timer_free(i);
+				break;
+			}
+		}
+	}
+	if (duration_ms == 0) {
+		*value = target;
+		return 0;
+	}
+
+	int i = __gui_timer_alloc();
+	if (i == NONE) {
+		*value = target; 	// no room to animate, jump to the end
+		return 0;
+	}
+	GUI_Timer *t = &timers[i];
+	t->value = value;
+	t->from = *value;
+	t->to = target;
+	t->start = SDL_GetTicks64();
+	t->duration = duration_ms;
+	t->easing = easing;
+	__gui_timer_link(i, LIST_TWEENS);
+	return __gui_timer_id(i);
+}
+
+// stop a timer or tween (ids of finished ones are ignored); a cancelled tween keeps its current value
+void GUI_CancelTimer(GUI_TimerID id) {
+	int i = __gui_timer_index(id);
+	if (i != NONE) __gui_timer_free(i);
+}
+
+// run due timers and advance tweens (GUI_PumpFrame, GUI_IsDirty and GUI_RenderElements call this)
+void GUI_UpdateTimers() {
+	if (!initialized) return;
+
+	Uint64 now = SDL_GetTicks64();
+	__gui_wheel_advance(now);
+	__gui_tweens_update(now);
+}
+
+/* Functions for in-library use only */
+
+// milliseconds until the next timer fires (-1: none), 'frame_interval' while a tween is running
+int __gui_scheduler_next_deadline(Uint32 frame_interval) {
+	if (!initialized) return -1;
+	if (heads[LIST_TWEENS] != NONE) return (int)frame_interval;
+
+	Uint64 next = 0;
+	int found = 0;
+
+	// the first occupied slot after the current one holds the earliest timers of its level
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		if (level_counts[level] == 0) continue;
+
+		Uint64 current = wheel_time >> (WHEEL_BITS * level);
+		for (int k = 1; k <= WHEEL_SLOTS; k++) {
+			int list = level * WHEEL_SLOTS + (int)((current + k) & WHEEL_MASK);
+			if (heads[list] == NONE) continue;
+
+			for (int i = heads[list]; i != NONE; i = timers[i].next) {
+				if (!found || timers[i].expires < next) next = timers[i].expires;
+				found = 1;
+			}
+			break;
+		}
+	}
+	if (!found) return -1;
+
+	Uint64 now = SDL_GetTicks64();
+	if (next <= now) return 0;
+	return (int)SDL_min(next - now, (Uint64)SDL_MAX_SINT32);
+}
+
+// drop all timers and tweens (GUI_Quit)
+void __gui_scheduler_quit() {
+	initialized = 0;
+}
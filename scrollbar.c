@@ -1,4 +1,3 @@
-#include <SDL2/SDL2_gfxPrimitives.h>
 #include "guilib.h"
 #include "defs.h"
 
@@ -30,45 +29,36 @@ void __gui_init_scrollbar(GUI_Scrollbar *sb, int x, int y, int height, int *scro
 }
 
 void __gui_render_scrollbar_arrows(GUI_Scrollbar *sb) {
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
-	Uint32 color_up, color_down; 	// arrow colors
-	int cx, cy; 					// center point coordinates
+	int cx, cy; 	// center point coordinates
 
 	// up arrow
 	if (sb->hovered_up)
-		color_up = __gui_color_to_uint32(SET_COLOR_SCROLLBAR_BUTTON_FOCUS);
+		__gui_set_color(SET_COLOR_SCROLLBAR_BUTTON_FOCUS);
 	else
-		color_up = __gui_color_to_uint32(SET_COLOR_SCROLLBAR_BUTTON_NORMAL);
+		__gui_set_color(SET_COLOR_SCROLLBAR_BUTTON_NORMAL);
 
 	cx = sb->up_button.x + sb->up_button.w / 2;
 	cy = sb->up_button.y + sb->up_button.h / 2;
-	aalineColor(renderer, cx - 4, cy + 2, cx, cy - 3, color_up); // SDL2_gfx
-	aalineColor(renderer, cx + 4, cy + 2, cx, cy - 3, color_up);
+	__gui_draw_sprite(GUI_SPRITE_ARROW_UP, 0, cx, cy);
 
 	// down arrow
 	if (sb->hovered_down)
-		color_down = __gui_color_to_uint32(SET_COLOR_SCROLLBAR_BUTTON_FOCUS);
+		__gui_set_color(SET_COLOR_SCROLLBAR_BUTTON_FOCUS);
 	else
-		color_down = __gui_color_to_uint32(SET_COLOR_SCROLLBAR_BUTTON_NORMAL);
+		__gui_set_color(SET_COLOR_SCROLLBAR_BUTTON_NORMAL);
 
 	cx = sb->down_button.x + sb->down_button.w / 2;
 	cy = sb->down_button.y + sb->down_button.h / 2;
 
-	aalineColor(renderer, cx - 4, cy - 2, cx, cy + 3, color_down);
-	aalineColor(renderer, cx + 4, cy - 2, cx, cy + 3, color_down);
+	__gui_draw_sprite(GUI_SPRITE_ARROW_DOWN, 0, cx, cy);
 }
 
 void __gui_render_scrollbar(GUI_Scrollbar *sb) {
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
-	// track
-	SDL_SetRenderDrawColor(renderer, SET_COLOR_SCROLLBAR_TRACK);
-	SDL_RenderFillRect(renderer, &sb->track);
 
-	// buttons' background rects
-	SDL_RenderFillRect(renderer, &sb->up_button);
-	SDL_RenderFillRect(renderer, &sb->down_button);
+	// track and buttons' background share a color and are stacked, fill them in one go
+	SDL_Rect column = { sb->x, sb->y, sb->width, sb->height };
+	__gui_set_color(SET_COLOR_SCROLLBAR_TRACK);
+	__gui_fill_rect(&column);
 
 	// arrows on buttons
 	__gui_render_scrollbar_arrows(sb);
@@ -1,5 +1,4 @@
 #include <SDL2/SDL.h>
-#include <stdlib.h> // malloc
 #include <stdio.h>  // printf
 #include <math.h> 	// roundf
 #include "guilib.h"
@@ -24,7 +23,8 @@ GUI_Slider *GUI_CreateSlider(int x, int y, int width, float min, float max, floa
 	if (value < min) value = min;
 	if (value > max) value = max;
 
-	GUI_Slider *s = malloc(sizeof(GUI_Slider));
+	GUI_Slider *s = __gui_alloc_element(GUI_SLIDER);
+	if (!s) return NULL;
 
 	*s = (GUI_Slider){
 		.tag = NULL,
@@ -69,7 +69,8 @@ GUI_Slider *GUI_CreateSliderEx(int x, int y, int width, int height, int knob_wid
 
 	if (knob_width > width) knob_width = width;
 
-	GUI_Slider *s = malloc(sizeof(GUI_Slider));
+	GUI_Slider *s = __gui_alloc_element(GUI_SLIDER);
+	if (!s) return NULL;
 
 	*s = (GUI_Slider){
 		.tag = NULL,
@@ -105,8 +106,6 @@ GUI_Slider *GUI_CreateSliderEx(int x, int y, int width, int height, int knob_wid
 void GUI_RenderSlider(GUI_Slider *slider) {
 	if (!slider || !slider->visible) return; // in case a NULL pointer gets passed or slider is hidden
 
-	SDL_Renderer *renderer = GUI_GetRenderer();
-
 	// track borders
 	__gui_draw_borders(slider->x, slider->y, slider->width, slider->height, slider->border_width);
 
@@ -115,14 +114,20 @@ void GUI_RenderSlider(GUI_Slider *slider) {
 
 	// apply track color
 	SDL_Color color = slider->dragging ? current_theme->input_active : current_theme->input_inactive;
-	SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-
-	// render the track
-	SDL_RenderFillRect(renderer, &track_rect);
+	__gui_set_color(color.r, color.g, color.b, color.a);
 
 	// adjust the knob's y position for if its height exceeds the track's height
 	int knob_y = slider->y + (slider->height / 2) - (slider->knob_height / 2);
 
+	// render the track around the knob (and its borders), which is drawn on top
+	SDL_Rect knob_outer = {
+		slider->pos_x - slider->border_width,
+		knob_y - slider->border_width,
+		slider->knob_width + slider->border_width * 2,
+		slider->knob_height + slider->border_width * 2
+	};
+	__gui_fill_rect_around(&track_rect, &knob_outer);
+
 	// knob borders
 	if (slider->border_width > 0)
 		__gui_draw_borders(slider->pos_x, knob_y, slider->knob_width, slider->knob_height, slider->border_width);
@@ -132,14 +137,14 @@ void GUI_RenderSlider(GUI_Slider *slider) {
 
 	// apply knob color
 	if (slider->dragging)
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_ACTIVE);
+		__gui_set_color(SET_COLOR_ACTIVE);
 	else if (slider->focus)
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_FOCUS);
+		__gui_set_color(SET_COLOR_FOCUS);
 	else
-		SDL_SetRenderDrawColor(renderer, SET_COLOR_NORMAL);
+		__gui_set_color(SET_COLOR_NORMAL);
 
 	// render the knob
-	SDL_RenderFillRect(renderer, &knob_rect);
+	__gui_fill_rect(&knob_rect);
 }
 
 static void __gui_update_slider(GUI_Slider *slider, int mx) {
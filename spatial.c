@@ -0,0 +1,191 @@
+/*
+	Spatial index for pointer routing. The plane is divided into
+	square cells and every element is listed in the cells its bounds
+	overlap, so finding the elements under the cursor means looking
+	at one cell instead of at all elements. Cells are hashed into a
+	fixed number of buckets, which also covers elements far outside
+	the window without a grid size to pick; elements of different
+	cells sharing a bucket are sorted out by their bounds.
+
+	Elements covering more than MAX_ELEMENT_CELLS cells (backgrounds,
+	huge lists) would crowd many buckets and sit in a list of their
+	own that every query checks. Entries are by slot, which stays the
+	same while the store compacts, and an element is only moved
+	between cells when the cells it covers change.
+*/
+
+#include <stdio.h>  // printf
+#include <SDL2/SDL.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define CELL_SIZE 			64 		// pixels
+#define BUCKET_COUNT 		1024 	// power of two
+#define MAX_ELEMENT_CELLS 	64 		// larger elements go to the list checked by every query
+
+typedef struct {
+	int *slots;
+	int count, cap;
+} GUI_Bucket;
+
+typedef enum { NOT_INDEXED, IN_CELLS, IN_LARGE } GUI_IndexState;
+
+typedef struct {
+	GUI_IndexState state;
+	SDL_Rect bounds; 			// as indexed
+	int x0, y0, x1, y1; 		// cells covered (inclusive)
+} GUI_SpatialEntry;
+
+static GUI_Bucket buckets[BUCKET_COUNT];
+static GUI_Bucket large = {0}; 				// elements covering too many cells
+static GUI_SpatialEntry *entries = NULL; 	// by slot
+static int entry_cap = 0;
+static GUI_Bucket results = {0}; 			// slots found by the last query
+
+/* Buckets */
+
+static int __gui_bucket_add(GUI_Bucket *b, int slot) {
+	for (int i = 0; i < b->count; i++)
+		if (b->slots[i] == slot) return 1; 	// another cell of the element hashed here already
+
+	if (b->count == b->cap) {
+		int cap = b->cap ? b->cap * 2 : 4;
+		int *grown = __gui_realloc(b->slots, sizeof(int) * cap, GUI_MEM_ELEMENTS);
+		if (!grown) return 0;
+		b->slots = grown;
+		b->cap = cap;
+	}
+	b->slots[b->count++] = slot;
+	return 1;
+}
+
+static void __gui_bucket_remove(GUI_Bucket *b, int slot) {
+	for (int i = 0; i < b->count; i++) {
+		if (b->slots[i] == slot) {
+			b->slots[i] = b->slots[--b->count]; 	// order doesn't matter
+			return;
+		}
+	}
+}
+
+static void __gui_bucket_free(GUI_Bucket *b) {
+	__gui_free(b->slots);
+	*b = (GUI_Bucket){0};
+}
+
+/* Cells */
+
+// cell of a coordinate, rounding down for negative ones too
+static int __gui_cell(int v) {
+	return v >= 0 ? v / CELL_SIZE : -((CELL_SIZE - 1 - v) / CELL_SIZE);
+}
+
+static GUI_Bucket *__gui_cell_bucket(int cx, int cy) {
+	Uint32 hash = (Uint32)cx * 73856093u ^ (Uint32)cy * 19349663u;
+	return &buckets[hash & (BUCKET_COUNT - 1)];
+}
+
+static int __gui_entry_contains(const GUI_SpatialEntry *e, int x, int y) {
+	return x >= e->bounds.x && x < e->bounds.x + e->bounds.w && y >= e->bounds.y && y < e->bounds.y + e->bounds.h;
+}
+
+static int __gui_spatial_reserve(int count) {
+	if (count <= entry_cap) return 1;
+
+	int cap = entry_cap ? entry_cap * 2 : 64;
+	while (cap < count) cap *= 2;
+
+	GUI_SpatialEntry *grown = __gui_realloc(entries, sizeof(GUI_SpatialEntry) * cap, GUI_MEM_ELEMENTS);
+	if (!grown) {
+		printf("\n[!] Failed to grow the spatial index to %d elements.\n", cap);
+		return 0;
+	}
+	for (int i = entry_cap; i < cap; i++) grown[i] = (GUI_SpatialEntry){ NOT_INDEXED };
+	entries = grown;
+	entry_cap = cap;
+	return 1;
+}
+
+/* Functions for in-library use only */
+
+// take an element out of the index (deleted, hidden)
+void __gui_spatial_remove(int slot) {
+	if (slot < 0 || slot >= entry_cap) return;
+
+	GUI_SpatialEntry *e = &entries[slot];
+	if (e->state == IN_LARGE) {
+		__gui_bucket_remove(&large, slot);
+	} else if (e->state == IN_CELLS) {
+		for (int cy = e->y0; cy <= e->y1; cy++)
+			for (int cx = e->x0; cx <= e->x1; cx++)
+				__gui_bucket_remove(__gui_cell_bucket(cx, cy), slot);
+	}
+	e->state = NOT_INDEXED;
+}
+
+// index an element under its current bounds, moving it only if the cells it covers changed
+void __gui_spatial_update(int slot, const SDL_Rect *bounds) {
+	if (slot < 0 || !__gui_spatial_reserve(slot + 1)) return;
+	if (bounds->w <= 0 || bounds->h <= 0) {
+		__gui_spatial_remove(slot);
+		return;
+	}
+
+	// process functions count the right and bottom edges as inside, one pixel past the bounds of borderless elements
+	SDL_Rect r = { bounds->x, bounds->y, bounds->w + 1, bounds->h + 1 };
+	int x0 = __gui_cell(r.x), y0 = __gui_cell(r.y);
+	int x1 = __gui_cell(r.x + r.w - 1), y1 = __gui_cell(r.y + r.h - 1);
+
+	GUI_SpatialEntry *e = &entries[slot];
+	if (e->state != NOT_INDEXED && e->x0 == x0 && e->y0 == y0 && e->x1 == x1 && e->y1 == y1) {
+		e->bounds = r; 	// same cells
+		return;
+	}
+	__gui_spatial_remove(slot);
+	*e = (GUI_SpatialEntry){ IN_CELLS, r, x0, y0, x1, y1 };
+
+	if ((Sint64)(x1 - x0 + 1) * (y1 - y0 + 1) > MAX_ELEMENT_CELLS) {
+		e->state = IN_LARGE;
+		if (!__gui_bucket_add(&large, slot)) e->state = NOT_INDEXED;
+		return;
+	}
+	for (int cy = y0; cy <= y1; cy++) {
+		for (int cx = x0; cx <= x1; cx++) {
+			if (!__gui_bucket_add(__gui_cell_bucket(cx, cy), slot)) {
+				printf("\n[!] Failed to add an element to the spatial index.\n");
+				__gui_spatial_remove(slot); 	// clears the cells it got into
+				return;
+			}
+		}
+	}
+}
+
+// is the point within the bounds an element was indexed with?
+int __gui_spatial_contains(int slot, int x, int y) {
+	return slot >= 0 && slot < entry_cap && entries[slot].state != NOT_INDEXED && __gui_entry_contains(&entries[slot], x, y);
+}
+
+// slots of the elements whose bounds contain the point, in no particular order (valid until the next query)
+int __gui_spatial_query(int x, int y, const int **slots) {
+	results.count = 0;
+
+	const GUI_Bucket *lists[2] = { __gui_cell_bucket(__gui_cell(x), __gui_cell(y)), &large };
+	for (int l = 0; l < 2; l++) {
+		for (int i = 0; i < lists[l]->count; i++) {
+			int slot = lists[l]->slots[i];
+			if (__gui_entry_contains(&entries[slot], x, y) && !__gui_bucket_add(&results, slot)) break;
+		}
+	}
+	*slots = results.slots;
+	return results.count;
+}
+
+// release the index (GUI_Quit)
+void __gui_spatial_quit() {
+	for (int i = 0; i < BUCKET_COUNT; i++) __gui_bucket_free(&buckets[i]);
+	__gui_bucket_free(&large);
+	__gui_bucket_free(&results);
+	__gui_free(entries);
+	entries = NULL;
+	entry_cap = 0;
+}
@@ -0,0 +1,195 @@
+/*
+	Widget sprite atlas. Small icons (checkmark, arrows, radio
+	button rings and discs) are rasterized once on the CPU as
+	alpha masks into a shared texture and drawn as one tinted
+	textured quad each, so every icon on screen goes out in
+	the same draw call.
+
+	Masks are rasterized at the renderer's scale factor (see
+	SDL_RenderSetScale) and kept per scale, so they stay sharp
+	when the UI is scaled. Colors come from the quad, a theme
+	switch doesn't touch the atlas.
+*/
+
+#include <stdio.h>  // printf
+#include <SDL2/SDL.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define ATLAS_SIZE 			256
+#define MAX_SPRITES 		64 		// distinct sprite, size and scale combinations
+#define SPRITE_PADDING 		1 		// empty pixels between sprites to prevent bleeding
+#define STROKE_WIDTH 		1.0f 	// line width of checkmarks and arrows
+
+typedef struct {
+	GUI_SpriteType type;
+	int size; 				// radius of rings and discs, unused otherwise
+	int scale; 				// renderer scale in quarters
+	SDL_Rect src; 			// mask within the atlas
+	SDL_Rect box; 			// logical area relative to the anchor point
+} GUI_Sprite;
+
+static SDL_Texture *atlas = NULL;
+static GUI_Sprite sprites[MAX_SPRITES];
+static int sprite_count = 0;
+static int shelf_x = 0, shelf_y = 0, shelf_h = 0;
+
+/* Shapes (logical coordinates, pixel centers at .5) */
+
+typedef struct {
+	float x1, y1, x2, y2;
+} GUI_Segment;
+
+// strokes of the line icons relative to their anchor (same geometry the line-drawn icons had)
+static const GUI_Segment checkmark[] = { { 3, 9, 7, 12 }, { 7, 12, 12, 4 } };
+static const GUI_Segment arrow_up[] = { { -4, 2, 0, -3 }, { 4, 2, 0, -3 } };
+static const GUI_Segment arrow_down[] = { { -4, -2, 0, 3 }, { 4, -2, 0, 3 } };
+static const GUI_Segment arrow_left[] = { { 1, -4, -4, 0 }, { 1, 4, -4, 0 } };
+static const GUI_Segment arrow_right[] = { { -1, -4, 4, 0 }, { -1, 4, 4, 0 } };
+
+static float __gui_segment_distance(const GUI_Segment *s, float x, float y) {
+	float dx = s->x2 - s->x1, dy = s->y2 - s->y1;
+	float t = ((x - s->x1) * dx + (y - s->y1) * dy) / (dx * dx + dy * dy);
+	t = SDL_clamp(t, 0, 1);
+	float px = s->x1 + dx * t - x, py = s->y1 + dy * t - y;
+	return SDL_sqrtf(px * px + py * py);
+}
+
+// logical area of a sprite around its anchor (top-left for the checkmark, center otherwise)
+static SDL_Rect __gui_sprite_box(GUI_SpriteType type, int size) {
+	switch (type) {
+	case GUI_SPRITE_CHECKMARK:
+		return (SDL_Rect){ 0, 0, 16, 16 };
+	case GUI_SPRITE_RING:
+	case GUI_SPRITE_DISC:
+		return (SDL_Rect){ -size - 2, -size - 2, size * 2 + 5, size * 2 + 5 };
+	default:
+		return (SDL_Rect){ -6, -6, 13, 13 }; 	// arrows
+	}
+}
+
+// coverage (0..1) of a sprite at a logical point, 'aa' is one device pixel in logical units
+static float __gui_sprite_coverage(GUI_SpriteType type, int size, float x, float y, float aa) {
+	const GUI_Segment *segments = NULL;
+	float distance;
+
+	switch (type) {
+	case GUI_SPRITE_CHECKMARK: segments = checkmark; break;
+	case GUI_SPRITE_ARROW_UP: segments = arrow_up; break;
+	case GUI_SPRITE_ARROW_DOWN: segments = arrow_down; break;
+	case GUI_SPRITE_ARROW_LEFT: segments = arrow_left; break;
+	case GUI_SPRITE_ARROW_RIGHT: segments = arrow_right; break;
+	case GUI_SPRITE_RING: 	// one pixel wide, centered on the radius
+		distance = SDL_fabsf(SDL_sqrtf(x * x + y * y) - size) - STROKE_WIDTH / 2;
+		return SDL_clamp(0.5f - distance / aa, 0, 1);
+	case GUI_SPRITE_DISC: 	// covers the pixels within the radius
+		distance = SDL_sqrtf(x * x + y * y) - (size + 0.5f);
+		return SDL_clamp(0.5f - distance / aa, 0, 1);
+	default:
+		return 0;
+	}
+
+	// line icons are two strokes each
+	distance = SDL_min(__gui_segment_distance(&segments[0], x, y), __gui_segment_distance(&segments[1], x, y));
+	return SDL_clamp(0.5f - (distance - STROKE_WIDTH / 2) / aa, 0, 1);
+}
+
+/* Atlas */
+
+static int __gui_sprites_create_atlas() {
+	atlas = SDL_CreateTexture(GUI_GetRenderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, ATLAS_SIZE, ATLAS_SIZE);
+	if (!atlas) {
+		printf("\n[!] Failed to create sprite atlas: %s\n", SDL_GetError());
+		return 0;
+	}
+	__gui_count_texture(atlas, 1);
+	SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+	SDL_SetTextureScaleMode(atlas, SDL_ScaleModeLinear); 	// masks may be drawn at fractional scales
+	return 1;
+}
+
+// make room for a mask, starting over when the atlas is full
+static int __gui_sprites_pack(int w, int h, SDL_Rect *src) {
+	if (w > ATLAS_SIZE || h > ATLAS_SIZE) return 0;
+
+	for (int attempt = 0; attempt < 2; attempt++) {
+		if (shelf_x + w > ATLAS_SIZE) {
+			shelf_y += shelf_h + SPRITE_PADDING;
+			shelf_x = shelf_h = 0;
+		}
+		if (shelf_y + h <= ATLAS_SIZE && sprite_count < MAX_SPRITES) {
+			*src = (SDL_Rect){ shelf_x, shelf_y, w, h };
+			shelf_x += w + SPRITE_PADDING;
+			if (h > shelf_h) shelf_h = h;
+			return 1;
+		}
+
+		// full: recorded quads still use the old masks, draw them before they're overwritten
+		__gui_batch_flush();
+		sprite_count = 0;
+		shelf_x = shelf_y = shelf_h = 0;
+	}
+	return 0;
+}
+
+static GUI_Sprite *__gui_get_sprite(GUI_SpriteType type, int size, int scale) {
+	for (int i = 0; i < sprite_count; i++) {
+		GUI_Sprite *s = &sprites[i];
+		if (s->type == type && s->size == size && s->scale == scale) return s;
+	}
+	if (!atlas && !__gui_sprites_create_atlas()) return NULL;
+
+	SDL_Rect box = __gui_sprite_box(type, size);
+	float pixel_scale = scale / 4.0f;
+	int w = (int)SDL_ceilf(box.w * pixel_scale), h = (int)SDL_ceilf(box.h * pixel_scale);
+
+	SDL_Rect src;
+	if (!__gui_sprites_pack(w, h, &src)) return NULL;
+
+	Uint32 *pixels = __gui_frame_alloc(sizeof(Uint32) * w * h); 	// scratch, gone after the frame
+	if (!pixels) return NULL;
+
+	// white with the coverage in alpha, tinted when drawn
+	for (int py = 0; py < h; py++) {
+		for (int px = 0; px < w; px++) {
+			// relative to the center of the anchor pixel
+			float x = box.x + (px + 0.5f) / pixel_scale - 0.5f, y = box.y + (py + 0.5f) / pixel_scale - 0.5f;
+			Uint8 alpha = (Uint8)(__gui_sprite_coverage(type, size, x, y, 1 / pixel_scale) * 255 + 0.5f);
+			pixels[py * w + px] = ((Uint32)alpha << 24) | 0xFFFFFF;
+		}
+	}
+	SDL_UpdateTexture(atlas, &src, pixels, w * sizeof(Uint32));
+
+	GUI_Sprite *s = &sprites[sprite_count++];
+	*s = (GUI_Sprite){ type, size, scale, src, box };
+	return s;
+}
+
+/* Drawing */
+
+// draw a sprite in the current color (see __gui_set_color) at its anchor point
+void __gui_draw_sprite(GUI_SpriteType type, int size, int x, int y) {
+	// rasterize for the renderer's scale, in quarter steps
+	float sx = 1, sy = 1;
+	SDL_RenderGetScale(GUI_GetRenderer(), &sx, &sy);
+	int scale = (int)(SDL_max(sx, sy) * 4 + 0.5f);
+	if (scale < 4) scale = 4;
+
+	GUI_Sprite *s = __gui_get_sprite(type, size, scale);
+	if (!s) return;
+
+	// the mask is rounded up to whole pixels, draw it at exactly that size
+	float w = s->src.w * 4.0f / scale, h = s->src.h * 4.0f / scale;
+	__gui_batch_quad(atlas, (float)(x + s->box.x), (float)(y + s->box.y), w, h,
+		(float)s->src.x / ATLAS_SIZE, (float)s->src.y / ATLAS_SIZE,
+		(float)(s->src.x + s->src.w) / ATLAS_SIZE, (float)(s->src.y + s->src.h) / ATLAS_SIZE, __gui_get_color());
+	__gui_batch_done();
+}
+
+// release the atlas (GUI_Quit)
+void __gui_sprites_quit() {
+	__gui_destroy_texture(atlas);
+	atlas = NULL;
+	sprite_count = 0;
+	shelf_x = shelf_y = shelf_h = 0;
+}
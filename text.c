@@ -0,0 +1,625 @@
+/*
+	Glyph atlas text engine. Every font (file and size) gets
+	its own atlas texture, glyphs are rasterized into it once (in white,
+	so they can be tinted with vertex colors) and strings
+	are drawn as textured quads through the geometry
+	batcher (batch.c).
+
+	Fonts opened in SDF mode share one distance field atlas
+	per typeface; every size is drawn from it by scaling the
+	quads (see GUI_SetSDFText).
+
+	Baked fonts (GUI_AddBakedFont) arrive with a complete
+	atlas and never call into SDL_ttf.
+*/
+
+#include <stdio.h>  // printf
+#include <string.h> // memset
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define ATLAS_WIDTH 		512
+#define ATLAS_MIN_HEIGHT 	256
+#define ATLAS_MAX_HEIGHT 	2048
+#define GLYPH_PADDING 		1 		// empty pixels between glyphs to prevent bleeding
+#define GLYPH_TABLE_SIZE 	128 	// initial glyph table capacity (power of two)
+#define KERNING_TABLE_SIZE 	256 	// initial kerning pair table capacity (power of two)
+#define FIT_CACHE_SIZE 		512 	// remembered fitting results (power of two)
+#define ELLIPSIS 			"\xE2\x80\xA6" 	// U+2026 horizontal ellipsis
+#define SDF_EDGE 			128 	// distance field value on the glyph outline
+#define SDF_SHARPNESS 		4 		// alpha ramp steepness applied to the distance field
+
+typedef struct {
+	Uint32 ch; 			// unicode code point
+	int used,
+		rasterized, 	// glyph image is present in the atlas
+		advance, 		// horizontal distance to the next glyph
+		offset_x; 		// x offset of the glyph image relative to the pen position
+	SDL_Rect src; 		// location within the atlas texture
+} GUI_Glyph;
+
+typedef struct {
+	Uint64 pair; 		// (previous << 32) | current code point, 0 marks an empty slot
+	int kerning;
+} GUI_KerningPair;
+
+typedef struct GUI_GlyphAtlas {
+	GUI_Font *font;
+	SDL_Texture *texture;
+	int width, height,
+		shelf_x, shelf_y, shelf_h; 	// shelf packer: current row position and height
+	GUI_Glyph *glyphs; 				// open-addressing table, keyed by code point
+	int glyph_cap, glyph_count;
+	GUI_KerningPair *kerning; 		// open-addressing table of already measured pairs
+	int kerning_cap, kerning_count,
+		has_kerning; 				// kerning is enabled for this font
+	const char *ellipsis; 			// U+2026 if the font has it, three dots otherwise (NULL until needed)
+} GUI_GlyphAtlas;
+
+// result of fitting a string into a width, keyed by font, width and a content hash
+typedef struct {
+	GUI_Font *font;
+	Uint32 hash;
+	int length, max_width,
+		used;
+	GUI_TextFit fit;
+} GUI_TextFitEntry;
+
+static GUI_TextFitEntry fit_cache[FIT_CACHE_SIZE];
+static int *fit_x = NULL, *fit_byte = NULL, fit_cap = 0; 	// scratch prefix sums used while fitting
+
+/* UTF-8 */
+
+// decode one code point and advance the pointer; invalid sequences yield U+FFFD
+Uint32 __gui_utf8_decode(const char **text, const char *end) {
+	const unsigned char *s = (const unsigned char *)*text;
+	Uint32 ch = s[0];
+	int len;
+
+	if (ch < 0x80) 			{ *text += 1; return ch; }
+	else if (ch < 0xC0) 	{ *text += 1; return 0xFFFD; } // stray continuation byte
+	else if (ch < 0xE0) 	{ ch &= 0x1F; len = 2; }
+	else if (ch < 0xF0) 	{ ch &= 0x0F; len = 3; }
+	else if (ch < 0xF8) 	{ ch &= 0x07; len = 4; }
+	else 					{ *text += 1; return 0xFFFD; }
+
+	if ((const char *)s + len > end) { *text = end; return 0xFFFD; } // truncated sequence
+
+	for (int i = 1; i < len; i++) {
+		if ((s[i] & 0xC0) != 0x80) { *text += i; return 0xFFFD; }
+		ch = (ch << 6) | (s[i] & 0x3F);
+	}
+	*text += len;
+	return ch;
+}
+
+/* Atlas management */
+
+static void __gui_atlas_create_texture(GUI_GlyphAtlas *atlas, int height) {
+	SDL_Renderer *renderer = GUI_GetRenderer();
+
+	if (atlas->texture) __gui_destroy_texture(atlas->texture);
+
+	atlas->width = ATLAS_WIDTH;
+	atlas->height = height;
+	atlas->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, atlas->width, atlas->height);
+	if (!atlas->texture) {
+		printf("\n[!] Failed to create glyph atlas: %s\n", SDL_GetError());
+		return;
+	}
+	__gui_count_texture(atlas->texture, 1);
+	SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+
+	// distance fields are drawn at any size, filter them smoothly
+	if (atlas->font->sdf)
+		SDL_SetTextureScaleMode(atlas->texture, SDL_ScaleModeLinear);
+
+	// static textures start out with undefined contents, clear to transparent
+	Uint32 *pixels = __gui_calloc(atlas->width * atlas->height, sizeof(Uint32), GUI_MEM_TEXT);
+	if (pixels) {
+		SDL_UpdateTexture(atlas->texture, NULL, pixels, atlas->width * sizeof(Uint32));
+		__gui_free(pixels);
+	}
+
+	// all previously packed glyphs are gone, their regions may be reused by others
+	atlas->shelf_x = atlas->shelf_y = atlas->shelf_h = 0;
+	for (int i = 0; i < atlas->glyph_cap; i++) {
+		atlas->glyphs[i].rasterized = 0;
+		atlas->glyphs[i].src = (SDL_Rect){0};
+	}
+}
+
+// each font owns one atlas, created on first use; SDF sizes share the atlas of their typeface
+static GUI_GlyphAtlas *__gui_get_atlas(GUI_Font *font) {
+	if (font->base) font = font->base;
+	if (font->atlas) return font->atlas;
+	if (!font->ttf) return NULL; 	// baked fonts come with their atlas
+
+	GUI_GlyphAtlas *atlas = __gui_calloc(1, sizeof(GUI_GlyphAtlas), GUI_MEM_TEXT);
+	if (!atlas) return NULL;
+
+	atlas->font = font;
+	atlas->glyph_cap = GLYPH_TABLE_SIZE;
+	atlas->glyphs = __gui_calloc(atlas->glyph_cap, sizeof(GUI_Glyph), GUI_MEM_TEXT);
+	atlas->kerning_cap = KERNING_TABLE_SIZE;
+	atlas->kerning = __gui_calloc(atlas->kerning_cap, sizeof(GUI_KerningPair), GUI_MEM_TEXT);
+	__gui_font_lock(font);
+	atlas->has_kerning = TTF_GetFontKerning(font->ttf);
+	__gui_font_unlock(font);
+
+	__gui_atlas_create_texture(atlas, ATLAS_MIN_HEIGHT);
+
+	font->atlas = atlas;
+	return atlas;
+}
+
+static GUI_Glyph *__gui_glyph_slot(GUI_Glyph *table, int cap, Uint32 ch) {
+	Uint32 i = (ch * 2654435761u) & (cap - 1);
+	while (table[i].used && table[i].ch != ch)
+		i = (i + 1) & (cap - 1);
+	return &table[i];
+}
+
+// look up glyph metrics, loading them on first use (does not rasterize)
+static GUI_Glyph *__gui_get_glyph(GUI_GlyphAtlas *atlas, Uint32 ch) {
+	GUI_Glyph *g = __gui_glyph_slot(atlas->glyphs, atlas->glyph_cap, ch);
+	if (g->used) return g;
+	if (!atlas->font->ttf) return NULL; 	// baked fonts only have the glyphs they were baked with
+
+	// keep the table at most half full
+	if ((atlas->glyph_count + 1) * 2 > atlas->glyph_cap) {
+		int new_cap = atlas->glyph_cap * 2;
+		GUI_Glyph *table = __gui_calloc(new_cap, sizeof(GUI_Glyph), GUI_MEM_TEXT);
+		if (!table) return NULL;
+
+		for (int i = 0; i < atlas->glyph_cap; i++)
+			if (atlas->glyphs[i].used)
+				*__gui_glyph_slot(table, new_cap, atlas->glyphs[i].ch) = atlas->glyphs[i];
+
+		__gui_free(atlas->glyphs);
+		atlas->glyphs = table;
+		atlas->glyph_cap = new_cap;
+		g = __gui_glyph_slot(table, new_cap, ch);
+	}
+
+	int minx = 0, advance = 0;
+	__gui_font_lock(atlas->font);
+	TTF_GlyphMetrics32(atlas->font->ttf, ch, &minx, NULL, NULL, NULL, &advance);
+	__gui_font_unlock(atlas->font);
+
+	*g = (GUI_Glyph){
+		.ch = ch,
+		.used = 1,
+		.rasterized = 0,
+		.advance = advance,
+		.offset_x = minx < 0 ? minx : 0, // SDL_ttf shifts the image right when the glyph extends left of the pen
+		.src = {0}
+	};
+	atlas->glyph_count++;
+	return g;
+}
+
+static GUI_KerningPair *__gui_kerning_slot(GUI_KerningPair *table, int cap, Uint64 pair) {
+	Uint32 i = (Uint32)((pair * 0x9E3779B97F4A7C15ull) >> 32) & (cap - 1);
+	while (table[i].pair && table[i].pair != pair)
+		i = (i + 1) & (cap - 1);
+	return &table[i];
+}
+
+// kerning between two glyphs, asked from SDL_ttf once per pair
+static int __gui_get_kerning(GUI_GlyphAtlas *atlas, Uint32 prev, Uint32 ch) {
+	if (!atlas->has_kerning || !prev || !atlas->kerning) return 0;
+
+	Uint64 pair = ((Uint64)prev << 32) | ch;
+	GUI_KerningPair *k = __gui_kerning_slot(atlas->kerning, atlas->kerning_cap, pair);
+	if (k->pair) return k->kerning;
+	if (!atlas->font->ttf) return 0; 	// baked fonts store every non-zero pair
+
+	// keep the table at most half full
+	if ((atlas->kerning_count + 1) * 2 > atlas->kerning_cap) {
+		int new_cap = atlas->kerning_cap * 2;
+		GUI_KerningPair *table = __gui_calloc(new_cap, sizeof(GUI_KerningPair), GUI_MEM_TEXT);
+		if (!table) return 0;
+
+		for (int i = 0; i < atlas->kerning_cap; i++)
+			if (atlas->kerning[i].pair)
+				*__gui_kerning_slot(table, new_cap, atlas->kerning[i].pair) = atlas->kerning[i];
+
+		__gui_free(atlas->kerning);
+		atlas->kerning = table;
+		atlas->kerning_cap = new_cap;
+		k = __gui_kerning_slot(table, new_cap, pair);
+	}
+
+	__gui_font_lock(atlas->font);
+	k->pair = pair;
+	k->kerning = TTF_GetFontKerningSizeGlyphs32(atlas->font->ttf, prev, ch);
+	__gui_font_unlock(atlas->font);
+	atlas->kerning_count++;
+	return k->kerning;
+}
+
+// rasterize a glyph into the atlas; returns 0 if the atlas is out of space
+static int __gui_rasterize_glyph(GUI_GlyphAtlas *atlas, GUI_Glyph *g) {
+	if (g->rasterized) return 1;
+
+	SDL_Color white = { 255, 255, 255, 255 };
+	__gui_font_lock(atlas->font);
+	SDL_Surface *surface = TTF_RenderGlyph32_Blended(atlas->font->ttf, g->ch, white);
+	__gui_font_unlock(atlas->font);
+
+	// whitespace and missing glyphs have nothing to draw
+	if (!surface || surface->w == 0 || surface->h == 0) {
+		if (surface) SDL_FreeSurface(surface);
+		g->src = (SDL_Rect){0};
+		g->rasterized = 1;
+		return 1;
+	}
+
+	// start a new shelf if the glyph doesn't fit into the current row
+	if (atlas->shelf_x + surface->w + GLYPH_PADDING > atlas->width) {
+		atlas->shelf_y += atlas->shelf_h + GLYPH_PADDING;
+		atlas->shelf_x = 0;
+		atlas->shelf_h = 0;
+	}
+	if (atlas->shelf_y + surface->h > atlas->height || surface->w > atlas->width) {
+		SDL_FreeSurface(surface);
+		return 0;
+	}
+
+	g->src = (SDL_Rect){ atlas->shelf_x, atlas->shelf_y, surface->w, surface->h };
+
+	SDL_Surface *converted = surface;
+	if (surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+		converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+
+	// no shaders to threshold the distance field with, so turn it into a steep alpha ramp around the outline
+	// (the ramp is made of distances, it stays smooth at any scale)
+	if (converted && atlas->font->sdf && SDL_LockSurface(converted) == 0) {
+		for (int y = 0; y < converted->h; y++) {
+			Uint32 *row = (Uint32 *)((Uint8 *)converted->pixels + y * converted->pitch);
+			for (int x = 0; x < converted->w; x++) {
+				int a = ((int)(row[x] >> 24) - SDF_EDGE) * SDF_SHARPNESS + SDF_EDGE;
+				row[x] = (row[x] & 0x00FFFFFF) | ((Uint32)SDL_clamp(a, 0, 255) << 24);
+			}
+		}
+		SDL_UnlockSurface(converted);
+	}
+
+	if (converted) {
+		SDL_UpdateTexture(atlas->texture, &g->src, converted->pixels, converted->pitch);
+		if (converted != surface) SDL_FreeSurface(converted);
+	}
+	SDL_FreeSurface(surface);
+
+	atlas->shelf_x += g->src.w + GLYPH_PADDING;
+	if (g->src.h > atlas->shelf_h) atlas->shelf_h = g->src.h;
+
+	g->rasterized = 1;
+	return 1;
+}
+
+// make sure every glyph of the string is present in the atlas
+static void __gui_prepare_glyphs(GUI_GlyphAtlas *atlas, const char *text, const char *end) {
+	for (int attempt = 0; attempt < 2; attempt++) {
+		const char *p = text;
+		int full = 0;
+
+		while (p < end && !full) {
+			GUI_Glyph *g = __gui_get_glyph(atlas, __gui_utf8_decode(&p, end));
+			if (g && !__gui_rasterize_glyph(atlas, g)) full = 1;
+		}
+		if (!full) return;
+
+		// out of space: grow the atlas (or start over at max size) and repack the string
+		int height = atlas->height * 2;
+		if (height > ATLAS_MAX_HEIGHT) height = ATLAS_MAX_HEIGHT;
+		__gui_atlas_create_texture(atlas, height);
+	}
+}
+
+// SDF fonts keep their metrics at the base size, scale them to the requested size
+static int __gui_scaled(GUI_Font *font, int value) {
+	return font->base ? (int)SDL_floorf(value * font->scale + 0.5f) : value;
+}
+
+// pen advance of a glyph at the font's own size, including kerning against the previous glyph (0: none)
+static int __gui_pen_advance(GUI_GlyphAtlas *atlas, GUI_Font *font, Uint32 prev, Uint32 ch, GUI_Glyph **glyph) {
+	GUI_Glyph *g = __gui_get_glyph(atlas, ch);
+	if (glyph) *glyph = g;
+	return __gui_scaled(font, __gui_get_kerning(atlas, prev, ch)) + (g ? __gui_scaled(font, g->advance) : 0);
+}
+
+/* Text engine interface */
+
+// measure the first 'len' bytes of a string (len < 0: whole string)
+void __gui_text_size(GUI_Font *font, const char *text, int len, int *width, int *height) {
+	int w = 0, h = 0;
+
+	GUI_GlyphAtlas *atlas = font ? __gui_get_atlas(font) : NULL;
+	if (atlas && text) {
+		const char *p = text;
+		const char *end = text + (len < 0 ? (int)strlen(text) : len);
+		Uint32 prev = 0;
+
+		while (p < end) {
+			Uint32 ch = __gui_utf8_decode(&p, end);
+			w += __gui_pen_advance(atlas, font, prev, ch, NULL);
+			prev = ch;
+		}
+		h = font->height;
+	}
+	if (width) *width = w;
+	if (height) *height = h;
+}
+
+// horizontal distance a glyph moves the pen, including kerning against the previous glyph (0: none)
+int __gui_text_advance(GUI_Font *font, Uint32 prev, Uint32 ch) {
+	GUI_GlyphAtlas *atlas = font ? __gui_get_atlas(font) : NULL;
+	return atlas ? __gui_pen_advance(atlas, font, prev, ch, NULL) : 0;
+}
+
+// draw the first 'len' bytes of a string (len < 0: whole string) with its top-left corner at x, y
+void __gui_text_draw(GUI_Font *font, const char *text, int len, int x, int y, SDL_Color color) {
+	if (!font || !text || !*text) return;
+
+	GUI_GlyphAtlas *atlas = __gui_get_atlas(font);
+	if (!atlas || !atlas->texture) return;
+
+	const char *end = text + (len < 0 ? (int)strlen(text) : len);
+	__gui_prepare_glyphs(atlas, text, end);
+
+	float scale = font->base ? font->scale : 1.0f;
+	const char *p = text;
+	Uint32 prev = 0;
+	int pen_x = x;
+
+	while (p < end) {
+		Uint32 ch = __gui_utf8_decode(&p, end);
+		GUI_Glyph *g = __gui_get_glyph(atlas, ch);
+		if (!g) continue;
+
+		// glyphs that didn't fit into a full atlas only take up their space
+		pen_x += __gui_scaled(font, __gui_get_kerning(atlas, prev, ch));
+		if (g->rasterized && g->src.w > 0) {
+			__gui_batch_quad(atlas->texture, pen_x + g->offset_x * scale, (float)y, g->src.w * scale, g->src.h * scale,
+				(float)g->src.x / atlas->width, (float)g->src.y / atlas->height,
+				(float)(g->src.x + g->src.w) / atlas->width, (float)(g->src.y + g->src.h) / atlas->height, color);
+		}
+
+		pen_x += __gui_scaled(font, g->advance);
+		prev = ch;
+	}
+	__gui_batch_done();
+}
+
+/* Fitting text into a width */
+
+static const char *__gui_ellipsis(GUI_GlyphAtlas *atlas) {
+	if (!atlas->ellipsis) {
+		if (atlas->font->ttf) {
+			__gui_font_lock(atlas->font);
+			atlas->ellipsis = TTF_GlyphIsProvided32(atlas->font->ttf, 0x2026) ? ELLIPSIS : "...";
+			__gui_font_unlock(atlas->font);
+		} else
+			atlas->ellipsis = __gui_glyph_slot(atlas->glyphs, atlas->glyph_cap, 0x2026)->used ? ELLIPSIS : "...";
+	}
+	return atlas->ellipsis;
+}
+
+// find how much of a string fits into max_width, cutting it short with an ellipsis if needed
+static GUI_TextFit __gui_text_fit_uncached(GUI_GlyphAtlas *atlas, GUI_Font *font, const char *text, int length, int max_width) {
+	GUI_TextFit fit = { length, 0, 0, NULL };
+
+	// a string of n bytes has at most n + 1 character boundaries
+	if (length + 1 > fit_cap) {
+		int cap = fit_cap ? fit_cap : 64;
+		while (cap < length + 1) cap *= 2;
+
+		int *x = __gui_realloc(fit_x, sizeof(int) * cap, GUI_MEM_TEXT);
+		if (x) fit_x = x;
+		int *byte = __gui_realloc(fit_byte, sizeof(int) * cap, GUI_MEM_TEXT);
+		if (byte) fit_byte = byte;
+		if (!x || !byte) return fit;
+
+		fit_cap = cap;
+	}
+
+	// prefix sums of glyph advances at every character boundary
+	const char *p = text;
+	const char *end = text + length;
+	Uint32 prev = 0;
+	int x = 0, count = 0;
+
+	fit_x[0] = fit_byte[0] = 0;
+	while (p < end) {
+		Uint32 ch = __gui_utf8_decode(&p, end);
+		x += __gui_pen_advance(atlas, font, prev, ch, NULL);
+		prev = ch;
+
+		count++;
+		fit_x[count] = x;
+		fit_byte[count] = (int)(p - text);
+	}
+
+	fit.width = x;
+	if (x <= max_width) return fit; // everything fits
+
+	// not even the ellipsis fits
+	const char *ellipsis = __gui_ellipsis(atlas);
+	int ellipsis_width;
+	__gui_text_size(font, ellipsis, -1, &ellipsis_width, NULL);
+
+	int room = max_width - ellipsis_width;
+	if (room < 0) {
+		fit.length = fit.width = 0;
+		return fit;
+	}
+
+	// binary search for the longest prefix that still leaves room for the ellipsis
+	int lo = 0, hi = count;
+	while (lo < hi) {
+		int mid = (lo + hi + 1) / 2;
+		if (fit_x[mid] <= room) lo = mid;
+		else hi = mid - 1;
+	}
+
+	// drop trailing spaces before the ellipsis
+	while (lo > 0 && text[fit_byte[lo] - 1] == ' ') lo--;
+
+	fit.length = fit_byte[lo];
+	fit.ellipsis_x = fit_x[lo];
+	fit.ellipsis = ellipsis;
+	fit.width = fit_x[lo] + ellipsis_width;
+	return fit;
+}
+
+// fit a string into max_width; results are remembered per font, width and string contents
+GUI_TextFit __gui_text_fit(GUI_Font *font, const char *text, int max_width) {
+	GUI_TextFit fit = { 0, 0, 0, NULL };
+	if (!font || !text) return fit;
+
+	GUI_GlyphAtlas *atlas = __gui_get_atlas(font);
+	if (!atlas) return fit;
+
+	int length = strlen(text);
+	Uint32 hash = __gui_hash_bytes(GUI_HASH_INIT, text, length);
+
+	Uint32 slot = (hash ^ ((Uint32)max_width * 2654435761u) ^ (Uint32)(uintptr_t)font) & (FIT_CACHE_SIZE - 1);
+	GUI_TextFitEntry *e = &fit_cache[slot];
+
+	if (e->used && e->font == font && e->hash == hash && e->length == length && e->max_width == max_width)
+		return e->fit;
+
+	fit = __gui_text_fit_uncached(atlas, font, text, length, max_width);
+	*e = (GUI_TextFitEntry){ font, hash, length, max_width, 1, fit };
+	return fit;
+}
+
+// draw a fitted string with its top-left corner at x, y
+void __gui_text_draw_fit(GUI_Font *font, const char *text, const GUI_TextFit *fit, int x, int y, SDL_Color color) {
+	if (!fit || fit->width <= 0) return;
+
+	if (fit->length > 0)
+		__gui_text_draw(font, text, fit->length, x, y, color);
+	if (fit->ellipsis)
+		__gui_text_draw(font, fit->ellipsis, -1, x + fit->ellipsis_x, y, color);
+}
+
+// drop the atlas of a font that is about to be closed
+void __gui_text_release_font(GUI_Font *font) {
+	GUI_GlyphAtlas *atlas = font->atlas;
+
+	// fitting results of this font would match a new font allocated at the same address
+	for (int i = 0; i < FIT_CACHE_SIZE; i++)
+		if (fit_cache[i].font == font) fit_cache[i].used = 0;
+
+	if (!atlas) return;
+
+	if (atlas->texture) __gui_destroy_texture(atlas->texture);
+	__gui_free(atlas->glyphs);
+	__gui_free(atlas->kerning);
+	__gui_free(atlas);
+	font->atlas = NULL;
+}
+
+/* Baked fonts */
+
+// build the atlas of a baked font from its mapped file (see GUI_BakedHeader), SDL_ttf is never used for it
+int __gui_text_load_baked(GUI_Font *font, const Uint8 *data, size_t size) {
+	const GUI_BakedHeader *header = (const GUI_BakedHeader *)data;
+	if (size < sizeof(GUI_BakedHeader) || header->magic != GUI_BAKED_MAGIC || header->version != GUI_BAKED_VERSION)
+		return 0;
+	if (header->atlas_width == 0 || header->atlas_width > 8192 || header->atlas_height > 8192 ||
+		header->glyph_count > 65536 || header->kerning_count > 1048576)
+		return 0;
+
+	size_t glyphs_size = (size_t)header->glyph_count * sizeof(GUI_BakedGlyph);
+	size_t kerning_size = (size_t)header->kerning_count * sizeof(GUI_BakedKerning);
+	size_t pixel_count = (size_t)header->atlas_width * header->atlas_height;
+	if (sizeof(GUI_BakedHeader) + glyphs_size + kerning_size + pixel_count > size) return 0; // truncated file
+
+	const GUI_BakedGlyph *glyphs = (const GUI_BakedGlyph *)(data + sizeof(GUI_BakedHeader));
+	const GUI_BakedKerning *kerning = (const GUI_BakedKerning *)((const Uint8 *)glyphs + glyphs_size);
+	const Uint8 *alpha = (const Uint8 *)kerning + kerning_size;
+
+	GUI_GlyphAtlas *atlas = __gui_calloc(1, sizeof(GUI_GlyphAtlas), GUI_MEM_TEXT);
+	if (!atlas) return 0;
+
+	// tables are sized up front to stay at most half full
+	atlas->font = font;
+	atlas->glyph_cap = GLYPH_TABLE_SIZE;
+	while (atlas->glyph_cap < (int)header->glyph_count * 2) atlas->glyph_cap *= 2;
+	atlas->kerning_cap = KERNING_TABLE_SIZE;
+	while (atlas->kerning_cap < (int)header->kerning_count * 2) atlas->kerning_cap *= 2;
+	atlas->glyphs = __gui_calloc(atlas->glyph_cap, sizeof(GUI_Glyph), GUI_MEM_TEXT);
+	atlas->kerning = __gui_calloc(atlas->kerning_cap, sizeof(GUI_KerningPair), GUI_MEM_TEXT);
+	atlas->has_kerning = header->kerning_count > 0;
+
+	// expand the alpha bytes into white glyphs, same as the ones rasterized at runtime
+	Uint32 *pixels = __gui_malloc(pixel_count * sizeof(Uint32), GUI_MEM_TEXT);
+
+	if (!atlas->glyphs || !atlas->kerning || (!pixels && pixel_count)) {
+		__gui_free(pixels);
+		__gui_free(atlas->glyphs);
+		__gui_free(atlas->kerning);
+		__gui_free(atlas);
+		return 0;
+	}
+
+	for (Uint32 i = 0; i < header->glyph_count; i++) {
+		const GUI_BakedGlyph *b = &glyphs[i];
+		GUI_Glyph *g = __gui_glyph_slot(atlas->glyphs, atlas->glyph_cap, b->ch);
+		if (g->used) continue; 	// duplicate entry
+
+		*g = (GUI_Glyph){
+			.ch = b->ch,
+			.used = 1,
+			.rasterized = 1, 	// already in the atlas
+			.advance = b->advance,
+			.offset_x = b->offset_x,
+			.src = { b->x, b->y, b->w, b->h }
+		};
+		atlas->glyph_count++;
+	}
+
+	for (Uint32 i = 0; i < header->kerning_count; i++) {
+		Uint64 pair = ((Uint64)kerning[i].left << 32) | kerning[i].right;
+		if (!kerning[i].left) continue; 	// pairs start with a glyph, 0 marks empty slots
+
+		GUI_KerningPair *k = __gui_kerning_slot(atlas->kerning, atlas->kerning_cap, pair);
+		if (k->pair) continue;
+
+		k->pair = pair;
+		k->kerning = kerning[i].kerning;
+		atlas->kerning_count++;
+	}
+
+	atlas->width = header->atlas_width;
+	atlas->height = header->atlas_height;
+	atlas->shelf_y = atlas->height; 	// nothing else is ever packed into a baked atlas
+
+	if (atlas->height > 0) {
+		atlas->texture = SDL_CreateTexture(GUI_GetRenderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, atlas->width, atlas->height);
+		if (!atlas->texture) {
+			printf("\n[!] Failed to create glyph atlas: %s\n", SDL_GetError());
+			__gui_free(pixels);
+			__gui_free(atlas->glyphs);
+			__gui_free(atlas->kerning);
+			__gui_free(atlas);
+			return 0;
+		}
+		__gui_count_texture(atlas->texture, 1);
+		SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+
+		for (size_t i = 0; i < pixel_count; i++)
+			pixels[i] = ((Uint32)alpha[i] << 24) | 0x00FFFFFF;
+		SDL_UpdateTexture(atlas->texture, NULL, pixels, atlas->width * sizeof(Uint32));
+	}
+	__gui_free(pixels);
+
+	font->atlas = atlas;
+	return 1;
+}
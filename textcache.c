@@ -0,0 +1,414 @@
+/*
+	Cache of rendered strings. Each entry holds the texture
+	of one string, keyed on font, text and style. Strings
+	are rendered in white and tinted when drawn (color and
+	alpha mod), so theme and state changes reuse them.
+	Entries are kept in LRU order and the least recently
+	used ones are evicted once the textures exceed the
+	memory budget.
+
+	New strings are rasterized by a pool of worker threads.
+	A pending entry reports its measured size but has no
+	texture yet; the surface is uploaded on the render thread
+	at the start of the next GUI_RenderElements().
+*/
+
+#include <stdio.h>  // printf
+#include <string.h> // memcpy, memcmp
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "guilib.h"
+#include "defs.h"
+
+#define CACHE_BUDGET 		(8 * 1024 * 1024) 	// default texture memory budget in bytes
+#define CACHE_BUCKETS 		1024 				// hash table size (power of two)
+#define MAX_WORKERS 		4 					// rasterizer threads
+
+typedef struct GUI_TextCacheEntry {
+	GUI_Font *font;
+	char *text; 		// null-terminated copy of the cached string
+	int len,
+		style,
+		width, height;
+	Uint32 hash;
+	size_t bytes; 		// texture memory used by this entry
+	int pins, 			// entries held by a layout are never evicted
+		pending; 		// queued for a worker, has no texture yet
+	SDL_Texture *texture;
+	SDL_Surface *surface; 	// worker output, waiting for upload
+	struct GUI_TextCacheEntry
+		*lru_prev, *lru_next, 	// recently used entries are at the head
+		*bucket_next, 			// next entry in the same hash bucket
+		*job_next; 				// next entry in the job or upload queue
+} GUI_TextCacheEntry;
+
+static GUI_TextCacheEntry *buckets[CACHE_BUCKETS];
+static GUI_TextCacheEntry *lru_head = NULL, *lru_tail = NULL;
+
+// worker pool, everything below is guarded by job_lock
+static SDL_Thread *workers[MAX_WORKERS];
+static int worker_count = 0,
+	worker_target = -1, 	// -1: pick from the CPU count, 0: rasterize synchronously
+	workers_busy = 0,
+	workers_stopping = 0;
+static SDL_mutex *job_lock = NULL;
+static SDL_cond *job_ready = NULL, *jobs_idle = NULL;
+static GUI_TextCacheEntry *job_head = NULL, *job_tail = NULL, 	// waiting for a worker
+	*done_head = NULL; 											// waiting for upload
+
+static GUI_TextCacheStats stats = { 0, 0, 0, 0, CACHE_BUDGET, 0 };
+
+/* Helper functions */
+
+static Uint32 __gui_text_cache_hash(GUI_Font *font, const char *text, int len, int style) {
+	Uint32 hash = GUI_HASH_INIT;
+	hash = __gui_hash_bytes(hash, &font, sizeof(font));
+	hash = __gui_hash_bytes(hash, &style, sizeof(style));
+	return __gui_hash_bytes(hash, text, len);
+}
+
+static void __gui_lru_unlink(GUI_TextCacheEntry *e) {
+	if (e->lru_prev) e->lru_prev->lru_next = e->lru_next;
+	else lru_head = e->lru_next;
+
+	if (e->lru_next) e->lru_next->lru_prev = e->lru_prev;
+	else lru_tail = e->lru_prev;
+
+	e->lru_prev = e->lru_next = NULL;
+}
+
+static void __gui_lru_push_front(GUI_TextCacheEntry *e) {
+	e->lru_prev = NULL;
+	e->lru_next = lru_head;
+	if (lru_head) lru_head->lru_prev = e;
+	lru_head = e;
+	if (!lru_tail) lru_tail = e;
+}
+
+static void __gui_text_cache_remove(GUI_TextCacheEntry *e) {
+	GUI_TextCacheEntry **link = &buckets[e->hash & (CACHE_BUCKETS - 1)];
+	while (*link && *link != e) link = &(*link)->bucket_next;
+	if (*link) *link = e->bucket_next;
+
+	__gui_lru_unlink(e);
+
+	stats.bytes -= e->bytes;
+	stats.entries--;
+
+	if (e->texture) __gui_destroy_texture(e->texture);
+	if (e->surface) SDL_FreeSurface(e->surface);
+	__gui_free(e->text);
+	__gui_free(e);
+}
+
+// evict least recently used entries until the cache fits its budget (the newest and pinned entries always stay)
+static void __gui_text_cache_trim() {
+	GUI_TextCacheEntry *e = lru_tail;
+	while (stats.bytes > stats.budget && e && e != lru_head) {
+		GUI_TextCacheEntry *prev = e->lru_prev;
+		if (!e->pins && !e->pending) {
+			__gui_text_cache_remove(e);
+			stats.evictions++;
+		}
+		e = prev;
+	}
+}
+
+/* Rasterization */
+
+// render an entry's string, called from workers as well as the render thread
+static SDL_Surface *__gui_text_cache_render(GUI_TextCacheEntry *e) {
+	__gui_font_lock(e->font); 	// SDL_ttf fonts can't be used by two threads at once
+
+	// render with the requested style, then restore the font's own style
+	int font_style = TTF_GetFontStyle(e->font->ttf);
+	if (font_style != e->style) TTF_SetFontStyle(e->font->ttf, e->style);
+	SDL_Color white = { 255, 255, 255, 255 };
+	SDL_Surface *surface = TTF_RenderUTF8_Blended(e->font->ttf, e->text, white);
+	if (font_style != e->style) TTF_SetFontStyle(e->font->ttf, font_style);
+
+	if (!surface) printf("\n[!] Failed to render text: %s\n", TTF_GetError());
+
+	__gui_font_unlock(e->font);
+	return surface;
+}
+
+// turn a rendered surface into the entry's texture (render thread only)
+static void __gui_text_cache_finish(GUI_TextCacheEntry *e, SDL_Surface *surface) {
+	e->pending = 0;
+	e->surface = NULL;
+
+	// a failed entry stays cached without a texture, so it isn't retried every frame
+	if (surface) {
+		e->width = surface->w;
+		e->height = surface->h;
+		e->bytes = (size_t)surface->w * surface->h * 4;
+		e->texture = SDL_CreateTextureFromSurface(GUI_GetRenderer(), surface);
+		__gui_count_texture(e->texture, 1);
+		SDL_FreeSurface(surface);
+		stats.bytes += e->bytes;
+	}
+	__gui_text_cache_trim();
+}
+
+static int __gui_text_worker(void *data) {
+	(void)data;
+	SDL_LockMutex(job_lock);
+
+	for (;;) {
+		while (!job_head && !workers_stopping) SDL_CondWait(job_ready, job_lock);
+		if (workers_stopping) break;
+
+		GUI_TextCacheEntry *e = job_head;
+		job_head = e->job_next;
+		if (!job_head) job_tail = NULL;
+		workers_busy++;
+		SDL_UnlockMutex(job_lock);
+
+		SDL_Surface *surface = __gui_text_cache_render(e);
+
+		SDL_LockMutex(job_lock);
+		e->surface = surface;
+		e->job_next = done_head;
+		done_head = e;
+		workers_busy--;
+		if (!job_head && !workers_busy) SDL_CondBroadcast(jobs_idle);
+	}
+	SDL_UnlockMutex(job_lock);
+	return 0;
+}
+
+// start the worker pool on first use, returns 0 if strings have to be rasterized synchronously
+static int __gui_text_workers_start() {
+	if (worker_count > 0) return 1;
+	if (worker_target == 0) return 0;
+
+	if (!job_lock) {
+		job_lock = SDL_CreateMutex();
+		job_ready = SDL_CreateCond();
+		jobs_idle = SDL_CreateCond();
+		if (!job_lock || !job_ready || !jobs_idle) {
+			worker_target = 0;
+			return 0;
+		}
+	}
+
+	// leave a core to the render thread
+	int count = worker_target > 0 ? worker_target : SDL_GetCPUCount() - 1;
+	if (count < 1) count = 1;
+	if (count > MAX_WORKERS) count = MAX_WORKERS;
+
+	workers_stopping = 0;
+	for (int i = 0; i < count; i++) {
+		workers[worker_count] = SDL_CreateThread(__gui_text_worker, "GUI text", NULL);
+		if (workers[worker_count]) worker_count++;
+	}
+	if (worker_count == 0) {
+		printf("\n[!] Failed to start text workers: %s\n", SDL_GetError());
+		worker_target = 0;
+	}
+	return worker_count > 0;
+}
+
+// wait until every queued string has been rasterized
+static void __gui_text_workers_wait() {
+	if (!job_lock) return;
+
+	SDL_LockMutex(job_lock);
+	while (job_head || workers_busy) SDL_CondWait(jobs_idle, job_lock);
+	SDL_UnlockMutex(job_lock);
+}
+
+static void __gui_text_workers_stop() {
+	if (worker_count == 0) return;
+
+	__gui_text_workers_wait();
+	SDL_LockMutex(job_lock);
+	workers_stopping = 1;
+	SDL_CondBroadcast(job_ready);
+	SDL_UnlockMutex(job_lock);
+
+	for (int i = 0; i < worker_count; i++)
+		SDL_WaitThread(workers[i], NULL);
+	worker_count = 0;
+
+	__gui_text_cache_upload(); 	// results of the last jobs
+}
+
+/* Text cache interface */
+
+// find a string in the cache, rendering it on a miss (len < 0: whole string)
+static GUI_TextCacheEntry *__gui_text_cache_lookup(GUI_Font *font, const char *text, int len, int style) {
+	if (!font || !font->ttf || !text) return NULL; 	// SDF sizes are drawn from the glyph atlas
+	if (len < 0) len = strlen(text);
+	if (len == 0) return NULL;
+
+	Uint32 hash = __gui_text_cache_hash(font, text, len, style);
+	GUI_TextCacheEntry *e = buckets[hash & (CACHE_BUCKETS - 1)];
+
+	for (; e; e = e->bucket_next) {
+		if (e->hash == hash && e->font == font && e->len == len && e->style == style && memcmp(e->text, text, len) == 0)
+			break;
+	}
+
+	if (e) {
+		stats.hits++;
+		if (e != lru_head) {
+			__gui_lru_unlink(e);
+			__gui_lru_push_front(e);
+		}
+	} else {
+		stats.misses++;
+
+		e = __gui_calloc(1, sizeof(GUI_TextCacheEntry), GUI_MEM_STRINGS);
+		char *copy = __gui_malloc(len + 1, GUI_MEM_STRINGS);
+		if (!e || !copy) {
+			__gui_free(e);
+			__gui_free(copy);
+			return NULL;
+		}
+		memcpy(copy, text, len);
+		copy[len] = '\0'; 	// SDL_ttf expects null-terminated strings
+
+		// until the texture arrives the entry reports the measured size of the string
+		int width, height;
+		__gui_text_size(font, copy, len, &width, &height);
+
+		*e = (GUI_TextCacheEntry){
+			.font = font,
+			.text = copy,
+			.len = len,
+			.style = style,
+			.width = width,
+			.height = height,
+			.hash = hash,
+			.pending = 1
+		};
+
+		e->bucket_next = buckets[hash & (CACHE_BUCKETS - 1)];
+		buckets[hash & (CACHE_BUCKETS - 1)] = e;
+		__gui_lru_push_front(e);
+
+		stats.entries++;
+
+		if (__gui_text_workers_start()) {
+			SDL_LockMutex(job_lock);
+			if (job_tail) job_tail->job_next = e;
+			else job_head = e;
+			job_tail = e;
+			SDL_CondSignal(job_ready);
+			SDL_UnlockMutex(job_lock);
+		} else {
+			__gui_text_cache_finish(e, __gui_text_cache_render(e));
+		}
+	}
+
+	return e;
+}
+
+// get a string's entry and pin it, so it stays cached until released
+GUI_TextCacheEntry *__gui_text_cache_acquire(GUI_Font *font, const char *text, int len, int style) {
+	GUI_TextCacheEntry *e = __gui_text_cache_lookup(font, text, len, style);
+	if (e) e->pins++;
+	return e;
+}
+
+void __gui_text_cache_release(GUI_TextCacheEntry *entry) {
+	if (!entry || entry->pins == 0) return;
+	if (--entry->pins == 0) __gui_text_cache_trim(); 	// may have been kept over budget
+}
+
+// the entry's texture, NULL while it's still being rasterized (the size is known either way)
+SDL_Texture *__gui_text_cache_texture(GUI_TextCacheEntry *entry, int *width, int *height) {
+	if (!entry) return NULL;
+	if (width) *width = entry->width;
+	if (height) *height = entry->height;
+	return entry->texture;
+}
+
+// upload strings finished by the workers, called by the render thread once per frame
+void __gui_text_cache_upload() {
+	if (!job_lock) return;
+
+	SDL_LockMutex(job_lock);
+	GUI_TextCacheEntry *e = done_head;
+	done_head = NULL;
+	SDL_UnlockMutex(job_lock);
+
+	while (e) {
+		GUI_TextCacheEntry *next = e->job_next;
+		e->job_next = NULL;
+		__gui_text_cache_finish(e, e->surface);
+		e = next;
+	}
+}
+
+// drop all entries rendered with a font that is about to be closed
+void __gui_text_cache_release_font(GUI_Font *font) {
+	// no worker may still be using the font
+	if (job_lock) {
+		SDL_LockMutex(job_lock);
+		GUI_TextCacheEntry **link = &job_head;
+		job_tail = NULL;
+		while (*link) {
+			if ((*link)->font == font) {
+				*link = (*link)->job_next; 	// never started, removed with the other entries below
+			} else {
+				job_tail = *link;
+				link = &(*link)->job_next;
+			}
+		}
+		SDL_UnlockMutex(job_lock);
+
+		__gui_text_workers_wait();
+		__gui_text_cache_upload();
+	}
+
+	GUI_TextCacheEntry *e = lru_head;
+	while (e) {
+		GUI_TextCacheEntry *next = e->lru_next;
+		if (e->font == font) __gui_text_cache_remove(e);
+		e = next;
+	}
+}
+
+// stop the worker pool (GUI_Quit)
+void __gui_text_cache_quit() {
+	__gui_text_workers_stop();
+
+	if (job_lock) {
+		SDL_DestroyCond(jobs_idle);
+		SDL_DestroyCond(job_ready);
+		SDL_DestroyMutex(job_lock);
+		job_lock = NULL;
+		job_ready = jobs_idle = NULL;
+	}
+}
+
+/* Functions for use by end user */
+
+// number of threads rasterizing new strings (0: render them synchronously, -1: default)
+void GUI_SetTextWorkers(int count) {
+	__gui_text_workers_stop(); 	// restarted with the new count on the next miss
+	worker_target = count < 0 ? -1 : count;
+}
+
+// set the texture memory budget of the text cache in bytes
+void GUI_SetTextCacheBudget(size_t bytes) {
+	stats.budget = bytes;
+	__gui_text_cache_trim();
+}
+
+void GUI_GetTextCacheStats(GUI_TextCacheStats *out) {
+	if (out) *out = stats;
+}
+
+// remove every entry that's not pinned by a layout or still being rasterized
+void GUI_ClearTextCache() {
+	GUI_TextCacheEntry *e = lru_head;
+	while (e) {
+		GUI_TextCacheEntry *next = e->lru_next;
+		if (!e->pins && !e->pending) __gui_text_cache_remove(e);
+		e = next;
+	}
+}